@@ -9,14 +9,77 @@
 #include <vector>
 #include <algorithm>
 
+#include <cmath>
+#include <cstring>
+
+#include <omp.h>
+
 #include "BaseMandelCalculator.h"
+#include "numa_placement.h"
+
+#define VIEW_SPAN 3.0 // extent of the default view along both axes
+#define MIRROR_TOLERANCE 1e-6 // largest distance of the mirrored line from the reflection of the calculated one [lines]
+
+static int windowFirstRow = 0;
+static int windowRows = 0;
+static const Viewport viewportDefault = {"-0.5", "0", 1.0, 0, 0};
+static Viewport viewportCurrent = viewportDefault;
 
 BaseMandelCalculator::BaseMandelCalculator(unsigned matrixBaseSize, unsigned limit, const std::string &cName)
-	: width(3 * matrixBaseSize), height(2 * matrixBaseSize), x_start(-2.0), x_fin(1.0), y_start(-1.5), y_fin(1.5), limit(limit), cName(cName)
+	: width(viewportCurrent.width ? viewportCurrent.width : 3 * matrixBaseSize), height(viewportCurrent.height ? viewportCurrent.height : 2 * matrixBaseSize),
+	  x_start(std::stod(viewportCurrent.centerRe) - VIEW_SPAN / 2 / viewportCurrent.zoom), x_fin(std::stod(viewportCurrent.centerRe) + VIEW_SPAN / 2 / viewportCurrent.zoom),
+	  y_start(std::stod(viewportCurrent.centerIm) - VIEW_SPAN / 2 / viewportCurrent.zoom), y_fin(std::stod(viewportCurrent.centerIm) + VIEW_SPAN / 2 / viewportCurrent.zoom),
+	  limit(limit), cName(cName), isaVariant("generic"), threads(omp_get_max_threads()), rowOffset(0), imageHeight(height), viewport(viewportCurrent),
+	  symmetric(false), mirrorAxis(-1), firstCalculatedRow(0), calculatedRows(height), mirrorReversed(false), classify(false), preparedCells(0), classifiedCells(0)
 
 {
-	dx = (x_fin - x_start) / (width - 1);
-	dy = (y_fin - y_start) / (height - 1);
+	viewport.width = width;
+	viewport.height = height;
+	// the step does not come from the bounds, they are the same number at deep zooms
+	dx = VIEW_SPAN / viewport.zoom / (width - 1);
+	dy = VIEW_SPAN / viewport.zoom / (height - 1);
+
+	if (windowRows > 0)
+	{
+		// the step stays the one of the whole image, the window starts at its first line
+		rowOffset = windowFirstRow;
+		height = windowRows;
+	}
+	selectSymmetry(Symmetry::REAL_AXIS);
+	classifier = ISA_DISPATCH(selectedIsa(), classifyLine);
+}
+
+void BaseMandelCalculator::selectSymmetry(Symmetry symmetry)
+{
+	symmetric = false;
+	mirrorAxis = -1;
+	mirrorReversed = symmetry == Symmetry::ORIGIN;
+	firstCalculatedRow = 0;
+	calculatedRows = height;
+	if (symmetry == Symmetry::NONE)
+		return;
+
+	// line j mirrors line i when y_0 + j * dy = -(y_0 + i * dy), i.e. i + j = -2 * y_0 / dy (y_0 of the whole image)
+	const double axis = -2.0 * y_start / dy;
+	const long pairSum = std::lround(axis);
+	bool mirrorable = std::fabs(axis - pairSum) < MIRROR_TOLERANCE && pairSum > 0 && pairSum < 2L * (imageHeight - 1);
+	// the rotation maps column i to column width - 1 - i only when the view is centered on the imaginary axis
+	if (symmetry == Symmetry::ORIGIN)
+		mirrorable = mirrorable && std::fabs(-2.0 * x_start / dx - (width - 1)) < MIRROR_TOLERANCE;
+	symmetric = symmetry == Symmetry::REAL_AXIS && mirrorable && pairSum == imageHeight - 1;
+
+	// a window is not mirrored
+	if (!mirrorable || height != imageHeight)
+		return;
+	// the lines overlapping with the reflection are calculated on the side of the axis with more lines
+	mirrorAxis = pairSum;
+	if (pairSum >= height - 1)
+		calculatedRows = pairSum / 2 + 1;
+	else
+	{
+		firstCalculatedRow = (pairSum + 1) / 2;
+		calculatedRows = height - firstCalculatedRow;
+	}
 }
 
 void BaseMandelCalculator::info(std::ostream &cout, bool batchMode)
@@ -25,15 +88,205 @@ void BaseMandelCalculator::info(std::ostream &cout, bool batchMode)
 	{
 		cout << cName << ";";
 		cout << width / 3 << ";";
-		cout << width << ";" << height << ";";
+		cout << width << ";" << imageHeight << ";";
 		cout << limit << ";";
+		cout << isaVariant << ";";
+		cout << threads << ";";
 	}
 	else
 	{
 		cout << "======================== Mandelbrot SIMD calculator ==========================" << std::endl;
 		cout << "Calculator:        " << cName << std::endl;
 		cout << "Base size:         " << width / 3 << std::endl;
-		cout << "Matrix size:       " << width << "x" << height << std::endl;
+		cout << "Matrix size:       " << width << "x" << imageHeight << std::endl;
 		cout << "Iteration limit:   " << limit << std::endl;
+		cout << "ISA variant:       " << isaVariant << std::endl;
+		cout << "Threads:           " << threads << std::endl;
+		if (viewport.centerRe != viewportDefault.centerRe || viewport.centerIm != viewportDefault.centerIm || viewport.zoom != viewportDefault.zoom)
+			cout << "View:              center " << viewport.centerRe << " " << viewport.centerIm << ", zoom " << viewport.zoom << std::endl;
+		if (selectedPlacement() != Placement::NONE)
+			cout << "Placement:         " << placementName(selectedPlacement()) << " over " << numaNodes() << " node(s)" << std::endl;
+	}
+}
+
+void BaseMandelCalculator::report(std::ostream &cout, bool batchMode)
+{
+	if (batchMode || !classify)
+		return;
+	cout << "Classified cells:  " << classifiedCells << " (" << (preparedCells ? 100.0 * classifiedCells / preparedCells : 0.0)
+		 << " % of the calculated cells skipped)" << std::endl;
+}
+
+long BaseMandelCalculator::evaluatedCells()
+{
+	if (preparedCells == 0)
+		return (long)width * height;
+	return preparedCells - classifiedCells;
+}
+
+float *BaseMandelCalculator::smoothData()
+{
+	return nullptr;
+}
+
+void BaseMandelCalculator::setClassifier(bool enabled)
+{
+	classify = enabled;
+}
+
+void BaseMandelCalculator::selectWindow(int firstRow, int rows)
+{
+	windowFirstRow = firstRow;
+	windowRows = rows;
+}
+
+void BaseMandelCalculator::selectViewport(const Viewport &viewport)
+{
+	viewportCurrent = viewport;
+}
+
+const Viewport &BaseMandelCalculator::selectedViewport()
+{
+	return viewportCurrent;
+}
+
+bool BaseMandelCalculator::isSymmetric() const
+{
+	return symmetric;
+}
+
+int BaseMandelCalculator::calculatedHeight() const
+{
+	return calculatedRows;
+}
+
+int BaseMandelCalculator::calculatedFirstRow() const
+{
+	return firstCalculatedRow;
+}
+
+double BaseMandelCalculator::yValue(int y_index) const
+{
+	return y_start + (rowOffset + y_index) * dy;
+}
+
+template <typename E>
+void BaseMandelCalculator::mirrorLine(E *data, int y_index)
+{
+	const int mirror = mirrorAxis - y_index;
+	if (mirrorAxis < 0 || mirror < 0 || mirror >= height || (mirror >= firstCalculatedRow && mirror < firstCalculatedRow + calculatedRows))
+		return;
+	const E *line = data + (size_t)y_index * width;
+	if (mirrorReversed)
+		std::reverse_copy(line, line + width, data + (size_t)mirror * width);
+	else
+		memcpy(data + (size_t)mirror * width, line, width * sizeof(E));
+}
+
+template void BaseMandelCalculator::mirrorLine<uint8_t>(uint8_t *data, int y_index);
+template void BaseMandelCalculator::mirrorLine<uint16_t>(uint16_t *data, int y_index);
+template void BaseMandelCalculator::mirrorLine<int>(int *data, int y_index);
+template void BaseMandelCalculator::mirrorLine<float>(float *data, int y_index);
+
+template <typename E>
+void BaseMandelCalculator::mirrorLines(E *data)
+{
+#pragma omp parallel for schedule(static)
+	for (int y_index = firstCalculatedRow; y_index < firstCalculatedRow + calculatedRows; y_index++)
+		mirrorLine(data, y_index);
+}
+
+template void BaseMandelCalculator::mirrorLines<uint8_t>(uint8_t *data);
+template void BaseMandelCalculator::mirrorLines<uint16_t>(uint16_t *data);
+template void BaseMandelCalculator::mirrorLines<int>(int *data);
+
+void BaseMandelCalculator::resetPrepared()
+{
+	preparedCells = 0;
+	classifiedCells = 0;
+}
+
+void BaseMandelCalculator::prepareLine(int *line, int y_index)
+{
+	// the lines may be prepared by several threads at once
+#pragma omp atomic
+	preparedCells += width;
+	if (classify)
+	{
+		const int classified = classifier(line, x_start, dx, yValue(y_index), width, limit);
+#pragma omp atomic
+		classifiedCells += classified;
+		return;
+	}
+	for (int x_index = 0; x_index < width; x_index++)
+		line[x_index] = CELL_PENDING;
+}
+
+template <typename E>
+void BaseMandelCalculator::placeMatrix(E *data)
+{
+	if (selectedPlacement() == Placement::NONE)
+		return;
+#pragma omp parallel
+	pinThread(omp_get_thread_num());
+
+#pragma omp parallel for schedule(runtime)
+	for (int y_index = firstCalculatedRow; y_index < firstCalculatedRow + calculatedRows; y_index++)
+	{
+		memset(data + (size_t)y_index * width, 0, width * sizeof(E));
+		mirrorLine(data, y_index);
 	}
 }
+
+template <typename E>
+void BaseMandelCalculator::reportPlacement(std::ostream &cout, const E *data)
+{
+	if (selectedPlacement() == Placement::NONE)
+		return;
+	const std::vector<long> pages = pagesPerNode(data, (size_t)width * height * sizeof(E));
+	long total = 0;
+	for (auto count : pages)
+		total += count;
+	cout << "Matrix pages:      ";
+	for (size_t node = 0; node < pages.size(); node++)
+		cout << (node ? ", " : "") << "node " << node << ": " << (total ? 100.0 * pages[node] / total : 0.0) << " %";
+	cout << std::endl;
+}
+
+template void BaseMandelCalculator::placeMatrix<uint8_t>(uint8_t *data);
+template void BaseMandelCalculator::placeMatrix<uint16_t>(uint16_t *data);
+template void BaseMandelCalculator::placeMatrix<int>(int *data);
+template void BaseMandelCalculator::reportPlacement<uint8_t>(std::ostream &cout, const uint8_t *data);
+template void BaseMandelCalculator::reportPlacement<uint16_t>(std::ostream &cout, const uint16_t *data);
+template void BaseMandelCalculator::reportPlacement<int>(std::ostream &cout, const int *data);
+
+int *BaseMandelCalculator::countLine(int *data, int y_index, int *)
+{
+	return data + (size_t)y_index * width;
+}
+
+template <typename E>
+int *BaseMandelCalculator::countLine(E *, int, int *scratch)
+{
+	return scratch;
+}
+
+void BaseMandelCalculator::storeLine(int *, int, const int *)
+{
+	// calculated in place
+}
+
+template <typename E>
+void BaseMandelCalculator::storeLine(E *data, int y_index, const int *line)
+{
+	E *output = data + (size_t)y_index * width;
+	// the counts are in [0, limit], the storage is selected to hold limit
+#pragma omp simd
+	for (int x_index = 0; x_index < width; x_index++)
+		output[x_index] = E(line[x_index]);
+}
+
+template int *BaseMandelCalculator::countLine<uint8_t>(uint8_t *data, int y_index, int *scratch);
+template int *BaseMandelCalculator::countLine<uint16_t>(uint16_t *data, int y_index, int *scratch);
+template void BaseMandelCalculator::storeLine<uint8_t>(uint8_t *data, int y_index, const int *line);
+template void BaseMandelCalculator::storeLine<uint16_t>(uint16_t *data, int y_index, const int *line);
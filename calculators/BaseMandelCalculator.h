@@ -11,6 +11,46 @@
 
 #include <string>
 #include <iostream>
+#include <cstdint>
+
+#include "ClassifierKernel.h"
+
+/**
+ * @brief Name of the floating point type a calculator iterates in
+ */
+template <typename T> inline const char *precisionName();
+template <> inline const char *precisionName<float>() { return "float"; }
+template <> inline const char *precisionName<double>() { return "double"; }
+
+/**
+ * @brief Name of the element type a calculator stores the iteration counts in
+ */
+template <typename E> inline const char *storageName();
+template <> inline const char *storageName<uint8_t>() { return "uint8"; }
+template <> inline const char *storageName<uint16_t>() { return "uint16"; }
+template <> inline const char *storageName<int>() { return "int32"; }
+
+/**
+ * @brief View of the complex plane, the default view (3 x 3 around -0.5) magnified zoom times around the center
+ */
+struct Viewport
+{
+    std::string centerRe; // decimal string, the perturbation calculator reads all its digits
+    std::string centerIm;
+    double zoom;
+    int width; // 0 = 3 x base size
+    int height; // 0 = 2 x base size
+};
+
+/**
+ * @brief Symmetry of the calculated set the calculators can exploit
+ */
+enum class Symmetry
+{
+    NONE,
+    REAL_AXIS, // the value at the complex conjugate is the same (Mandelbrot set, Multibrot sets, Julia sets of real c)
+    ORIGIN // the value at -z is the same (Julia sets of even exponents)
+};
 
 /**
  * @brief Abstract class for Mandelbrot set calculator, calculates the dimensions
@@ -35,6 +75,57 @@ public:
      * @param batchMode true = compact CSV output
      */
     void info(std::ostream & cout, bool batchMode);
+
+    /**
+     * @brief Prints calculator specific statistics of the last calculation to ostream
+     *
+     * @param cout output stream
+     * @param batchMode true = compact CSV output
+     */
+    virtual void report(std::ostream & cout, bool batchMode);
+
+    /**
+     * @brief Number of cells the kernels iterated in the last calculation
+     *
+     * Defaults to the prepared cells the classifier did not resolve, or to the whole matrix
+     * for the calculators that do not prepare their lines.
+     */
+    virtual long evaluatedCells();
+
+    /**
+     * @brief Smooth iteration counts of the last calculation (width x height), nullptr for the calculators
+     *        that calculate the integer counts only
+     */
+    virtual float *smoothData();
+
+    /**
+     * @brief Enables the closed-form classifier pre-pass (cardioid, period-2 bulb, |c| > 2)
+     */
+    void setClassifier(bool enabled);
+
+    /**
+     * @brief Restricts the calculators constructed from now on to the lines [firstRow, firstRow + rows) of the image
+     *
+     * The matrix of such a calculator holds the window only and its lines are not mirrored. rows = 0 selects
+     * the whole image again.
+     */
+    static void selectWindow(int firstRow, int rows);
+
+    /**
+     * @brief Sets the view of the calculators constructed from now on
+     */
+    static void selectViewport(const Viewport &viewport);
+
+    /**
+     * @brief View of the calculators constructed from now on
+     */
+    static const Viewport &selectedViewport();
+
+    /**
+     * @brief The set is symmetric about the real axis and the real axis is the middle of the image,
+     *        the second half of the image can be mirrored from the first one
+     */
+    bool isSymmetric() const;
     
     int width; // width of the set
     int height; // hegiht of the set
@@ -44,11 +135,119 @@ protected:
     const std::string cName;
     const int limit;
     bool batchMode;
+    std::string isaVariant; // instruction set the calculator kernel was compiled for
+    int threads; // number of OpenMP threads available to the calculator
+    int rowOffset; // line of the image the first line of the matrix belongs to (see selectWindow)
+    int imageHeight; // lines of the whole image, equal to height without a window
+    Viewport viewport; // view of the image, with its actual dimensions
+    bool symmetric; // the set is symmetric about the real axis, which is the middle of the image
+    int mirrorAxis; // sum of the indices of two lines mirroring each other, -1 when no line of the matrix is mirrored
+    int firstCalculatedRow; // the lines [firstCalculatedRow, firstCalculatedRow + calculatedRows) are calculated,
+    int calculatedRows;     // all the others mirror one of them
+    bool mirrorReversed; // the mirrored lines are rotated about the origin, their columns are reversed
+
+    bool classify; // resolve cells analytically before iterating
+    long preparedCells; // cells passed through prepareLine since the last resetPrepared
+    long classifiedCells; // cells resolved by the classifier since the last resetPrepared
+    decltype(&isa_sse42::classifyLine) classifier; // classifier compiled for the selected ISA
+
+    /**
+     * @brief Prepares the line for the iteration kernels, the kernels calculate its CELL_PENDING cells only
+     *
+     * @param line output line (width cells)
+     * @param y_index index of the line
+     */
+    void prepareLine(int * line, int y_index);
+
+    /**
+     * @brief Resets the prepared and classified cell counters, called at the start of calculation
+     */
+    void resetPrepared();
+
+    /**
+     * @brief Sets the symmetry the lines are mirrored by (REAL_AXIS unless a calculator selects another one)
+     *
+     * Has to be called in the constructor of the calculator, before it reads the calculated lines.
+     * The origin symmetry is used only when the view is centered on the imaginary axis, so that whole
+     * lines map onto whole lines.
+     */
+    void selectSymmetry(Symmetry symmetry);
+
+    /**
+     * @brief Number of lines the calculator has to iterate, the lines of the view overlapping with its reflection
+     *        across the real axis are calculated once
+     */
+    int calculatedHeight() const;
+
+    /**
+     * @brief First line the calculator has to iterate, the calculated lines follow it
+     */
+    int calculatedFirstRow() const;
+
+    /**
+     * @brief Imaginary part of c of the line y_index of the matrix
+     *
+     * Always taken from the first line of the image, so that the line of a window gets the same value
+     * as the line of the whole image.
+     */
+    double yValue(int y_index) const;
+
+    /**
+     * @brief Copies the calculated line to the line mirroring it (reversed for the origin symmetry), if there is one
+     *
+     * @tparam E element type of the matrix (uint8_t, uint16_t or int for the counts, float for the smooth counts)
+     */
+    template <typename E>
+    void mirrorLine(E * data, int y_index);
+
+    /**
+     * @brief Copies all the calculated lines to the lines mirroring them
+     */
+    template <typename E>
+    void mirrorLines(E * data);
+
+    /**
+     * @brief Pins the threads and first-touches the matrix by the threads that will calculate it
+     *
+     * Does nothing without a selected placement. Every calculated row is touched together with
+     * its mirrored row using the runtime schedule of the calculation, which has to be static (enforced by
+     * main), so that the pages are put on the node of the thread calculating them.
+     *
+     * @param data matrix (width x height cells), not touched yet
+     */
+    template <typename E>
+    void placeMatrix(E * data);
+
+    /**
+     * @brief Prints the share of the matrix pages resident on every NUMA node
+     */
+    template <typename E>
+    void reportPlacement(std::ostream & cout, const E * data);
+
+    /**
+     * @brief Line the kernels calculate the counts of line y_index of the matrix in
+     *
+     * The kernels calculate int counts (marking the pending cells by CELL_PENDING). An int matrix is
+     * calculated in place, a narrower one in the scratch line of the thread, which storeLine then narrows
+     * into the matrix.
+     *
+     * @param scratch line of width cells of the calculating thread
+     */
+    int * countLine(int * data, int y_index, int * scratch);
+    template <typename E>
+    int * countLine(E * data, int y_index, int * scratch);
+
+    /**
+     * @brief Stores the counts calculated in the line returned by countLine into line y_index of the matrix
+     */
+    void storeLine(int * data, int y_index, const int * line);
+    template <typename E>
+    void storeLine(E * data, int y_index, const int * line);
 
 
 	const double x_start; // minimal real value
 	const double x_fin; // maximal real value
-	const double y_start; // minimal imag value
+	double y_start; // minimal imag value (of the first line of the image, see yValue)
 	const double y_fin; // maximal imag value
 	
     double dx; // step of real vaues
@@ -11,7 +11,11 @@
 #include <algorithm>
 
 #include <cstdlib>
+#include <numeric>
 #include <stdexcept>
+#include <type_traits>
+
+#include <omp.h>
 
 #include "BatchMandelCalculator.h"
 
@@ -20,10 +24,8 @@ using std::cerr;
 using std::endl;
 
 #define ALIGN_SIZE 64                           // align memory to 64 bytes (for the AVX512 registers: 64B = 512b)
-#define SIMD_LEN_INT (512/(sizeof(int)*8))      // number of integers in AVX512 register
-#define SIMD_LEN_FLOAT (512/(sizeof(float)*8))  // number of floats in AVX512 register
-#define BATCH_SIZE 64                           // number of cells to calculate in one batch
 #define BATCH_MEM_ALLOC_ERR 2000                // error code for memory allocation failure
+#define BATCH_STREAMS_ERR 2001                  // error code for a number of streams without a compiled kernel
 
 
 //#define DEBUG   // uncomment this line to enable debug printing
@@ -33,20 +35,55 @@ using std::endl;
 #define D_PRINT(x)
 #endif
 
-BatchMandelCalculator::BatchMandelCalculator(unsigned matrixBaseSize, unsigned limit) :
-        BaseMandelCalculator(matrixBaseSize, limit, "BatchMandelCalculator") {
+template <typename T, typename E>
+BatchMandelCalculator<T, E>::BatchMandelCalculator(unsigned matrixBaseSize, unsigned limit, bool periodicity, bool refill, int streams, bool costPartition) :
+        BaseMandelCalculator(matrixBaseSize, limit, std::string("BatchMandelCalculator<") + precisionName<T>()
+                                                    + (std::is_same<E, int>::value ? "" : std::string(", ") + storageName<E>()) + ">"
+                                                    + (streams > 1 ? "(S=" + std::to_string(streams) + ")" : "")),
+        cost_partition(costPartition), partition_stats({0, 0.0, 0.0, 0.0, 0.0}),
+        periodicity(periodicity), periodicity_stats({0, 0}), refill(refill), refill_stats({0, 0}) {
+    // pick the kernels compiled for the ISA selected at startup
+    switch (streams) {
+        case 1:
+            kernel = ISA_DISPATCH(selectedIsa(), calculateBatchLine<T, 1>);
+            break;
+        case 2:
+            kernel = ISA_DISPATCH(selectedIsa(), calculateBatchLine<T, 2>);
+            break;
+        case 3:
+            kernel = ISA_DISPATCH(selectedIsa(), calculateBatchLine<T, 3>);
+            break;
+        case 4:
+            kernel = ISA_DISPATCH(selectedIsa(), calculateBatchLine<T, 4>);
+            break;
+        default:
+            cerr << typeid(*this).name() << " : Unsupported number of streams " << streams << ". Aborting." << endl;
+            exit(BATCH_STREAMS_ERR);
+    }
+    periodic_kernel = ISA_DISPATCH(selectedIsa(), calculateBatchLinePeriodic<T>);
+    refill_kernel = ISA_DISPATCH(selectedIsa(), calculateBatchLineRefill<T>);
+    isaVariant = isaName(selectedIsa());
     // allocate main data matrix
-    data = (int *) (aligned_alloc(ALIGN_SIZE, height * width * sizeof(int)));
-    // allocate helper arrays
-    z_x_temp = (float *) (aligned_alloc(ALIGN_SIZE, BATCH_SIZE * sizeof(float)));
-    z_y_temp = (float *) (aligned_alloc(ALIGN_SIZE, BATCH_SIZE * sizeof(float)));
+    data = (E *) (aligned_alloc(ALIGN_SIZE, height * width * sizeof(E)));
+    // allocate helper arrays, every thread has its own part
+    scratch_stride = streams * BATCH_SIZE;
+    z_x_temp = (T *) (aligned_alloc(ALIGN_SIZE, threads * scratch_stride * sizeof(T)));
+    z_y_temp = (T *) (aligned_alloc(ALIGN_SIZE, threads * scratch_stride * sizeof(T)));
+    line_stride = (width + 15) / 16 * 16;       // whole cache lines, so that the threads do not share them
+    line_temp = (int *) (aligned_alloc(ALIGN_SIZE, threads * line_stride * sizeof(int)));
+    saved_x_temp = periodicity ? (T *) (aligned_alloc(ALIGN_SIZE, threads * scratch_stride * sizeof(T))) : nullptr;
+    saved_y_temp = periodicity ? (T *) (aligned_alloc(ALIGN_SIZE, threads * scratch_stride * sizeof(T))) : nullptr;
     // check allocation success
-    if (data == nullptr or z_x_temp == nullptr or z_y_temp == nullptr) {
+    if (data == nullptr or z_x_temp == nullptr or z_y_temp == nullptr or line_temp == nullptr or
+        (periodicity and (saved_x_temp == nullptr or saved_y_temp == nullptr))) {
         cerr << typeid(*this).name() << " : Memory allocation failed. Aborting." << endl;
         exit(BATCH_MEM_ALLOC_ERR);
     }
     // we use the fact that mandelbrot is symmetrical, therefore we only calculate half and then copy it
-    half_height = height / 2;
+    half_height = calculatedHeight();
+    first_row = calculatedFirstRow();
+    // pin the threads and place the matrix pages on their nodes (with a selected placement only)
+    placeMatrix(data);
     matrix_base_size = matrixBaseSize;
     D_PRINT(typeid(*this).name() << " : half_height=" << half_height
                                  << " height=" << height
@@ -55,7 +92,8 @@ BatchMandelCalculator::BatchMandelCalculator(unsigned matrixBaseSize, unsigned l
                                  << endl);
 }
 
-BatchMandelCalculator::~BatchMandelCalculator() {
+template <typename T, typename E>
+BatchMandelCalculator<T, E>::~BatchMandelCalculator() {
     // free allocated data with checking against the memory validity
     if (data != nullptr) {
         free(data);
@@ -66,60 +104,127 @@ BatchMandelCalculator::~BatchMandelCalculator() {
     if (z_y_temp != nullptr) {
         free(z_y_temp);
     }
+    if (line_temp != nullptr) {
+        free(line_temp);
+    }
+    if (saved_x_temp != nullptr) {
+        free(saved_x_temp);
+    }
+    if (saved_y_temp != nullptr) {
+        free(saved_y_temp);
+    }
 }
 
 
-int *BatchMandelCalculator::calculateMandelbrot() {
+template <typename T, typename E>
+E *BatchMandelCalculator<T, E>::calculateMandelbrot() {
     D_PRINT(typeid(*this).name() << " : calculateMandelbrot(): " << matrix_base_size / BATCH_SIZE << endl);
-    // prefill default values to the data array, vectorize it
-    for (auto i = 0; i < height * width; i++) {
-        data[i] = limit;
-    }
-
-    // iterate over the first half of the lines
-    for (auto y_index = 0; y_index <= half_height; y_index++) {
-        // calculate the y value for the current line (given by the y_index)
-        auto y_value = float(y_start + y_index * dy);
-        // iterate over the batches in the current line
-        D_PRINT("y_index: " << y_index << " y_value: " << y_value << endl);
-        for (auto batch_start_index = 0; batch_start_index < width; batch_start_index += BATCH_SIZE) {
-            // fill up the helper arrays with the current batch values
-            D_PRINT("batch_start_index: " << batch_start_index << endl);
-            for (auto batch_inner_index = 0; batch_inner_index < BATCH_SIZE; batch_inner_index++) {
-                z_x_temp[batch_inner_index] = float(x_start + (batch_start_index + batch_inner_index) * dx);
-                z_y_temp[batch_inner_index] = y_value;
-                D_PRINT("TOTAL INDEX: " << batch_start_index + batch_inner_index << endl);
-            }
+    resetPrepared();
+
+    long retired = 0, saved_iterations = 0;
+    long busy_lanes = 0, total_lanes = 0;
+
+    // with the cost partition every thread calculates one band of lines of equal predicted cost,
+    // otherwise every line is a band of its own and the expensive ones are spread over the threads dynamically
+    std::vector<int> bands(half_height + 1);
+    std::vector<double> band_time;
+    if (cost_partition) {
+        // the plain kernel iterates every batch with a cell left up to the limit, the periodic one until it is done
+        CostMap cost_map(width, half_height, x_start, dx, yValue(first_row), dy, limit,
+                         refill ? 1 : BATCH_SIZE, refill or periodicity);
+        bands = cost_map.partition(threads);
+        for (auto &boundary : bands) {
+            boundary += first_row;
+        }
+        band_time.assign(threads, 0.0);
+        partition_stats = cost_map.predict(bands);
+    } else {
+        std::iota(bands.begin(), bands.end(), first_row);
+    }
+    const int band_count = bands.size() - 1;
+
+    // the bands of the cost partition are assigned statically, band b (and its time) belongs to thread b
+    omp_sched_t schedule_kind;
+    int schedule_chunk;
+    omp_get_schedule(&schedule_kind, &schedule_chunk);
+    if (cost_partition) {
+        omp_set_schedule(omp_sched_static, 1);
+    }
 
-            // calculate the mandelbrot values for the current batch
-            for (auto iteration = 0; iteration < limit; iteration++) {
-                // cycle over the helper arrays and calculate
-                for (auto batch_inner_index = 0; batch_inner_index < BATCH_SIZE; batch_inner_index++) {
-                    auto x_index = batch_start_index + batch_inner_index;
-                    if (data[y_index * width + x_index] == limit) { // TODO - move to if on 104 to improve vectorization?
-
-                        auto x_value = float(x_start + x_index * dx);
-
-                        auto z_x = z_x_temp[batch_inner_index];
-                        auto z_y = z_y_temp[batch_inner_index];
-
-                        auto z_x2 = z_x * z_x;
-                        auto z_y2 = z_y * z_y;
-
-                        if (z_x2 + z_y2 > 4.0f) {
-                            data[y_index * width + x_index] = iteration;
-                        } else {
-                            z_y_temp[batch_inner_index] = 2.0f * z_x * z_y + y_value;
-                            z_x_temp[batch_inner_index] = z_x2 - z_y2 + x_value;
-                        }
-                    }
-                }
+#pragma omp parallel for schedule(runtime) reduction(+:retired, saved_iterations, busy_lanes, total_lanes)
+    for (int band = 0; band < band_count; band++) {
+        const double band_start = omp_get_wtime();
+        for (int y_index = bands[band]; y_index < bands[band + 1]; y_index++) {
+            // helper arrays of the current thread
+            const int offset = omp_get_thread_num() * scratch_stride;
+
+            // calculate the y value for the current line (given by the y_index)
+            auto y_value = T(yValue(y_index));
+            D_PRINT("y_index: " << y_index << " y_value: " << y_value << endl);
+
+            // the matrix line itself, or the scratch line of the thread for a narrow matrix
+            int *line = countLine(data, y_index, line_temp + omp_get_thread_num() * line_stride);
+
+            // calculate the current line batch by batch
+            prepareLine(line, y_index);
+            if (periodicity) {
+                PeriodicityStats stats = periodic_kernel(line, z_x_temp + offset, z_y_temp + offset,
+                                                         saved_x_temp + offset, saved_y_temp + offset,
+                                                         y_value, x_start, dx, width, limit);
+                retired += stats.retired;
+                saved_iterations += stats.savedIterations;
+            } else if (refill) {
+                RefillStats stats = refill_kernel(line, z_x_temp + offset, z_y_temp + offset,
+                                                  y_value, x_start, dx, width, limit);
+                busy_lanes += stats.busyLanes;
+                total_lanes += stats.totalLanes;
+            } else {
+                kernel(line, z_x_temp + offset, z_y_temp + offset, y_value, x_start, dx, width, limit);
             }
+
+            storeLine(data, y_index, line);
+            // copy the calculated line to the line mirroring it across the real axis (a window is not mirrored)
+            mirrorLine(data, y_index);
         }
-        // copy the calculated line to the second half of the matrix
-        for (auto x_index = 0; x_index < width; x_index++) {
-            data[(height - y_index - 1) * width + x_index] = data[y_index * width + x_index];
+        if (cost_partition) {
+            band_time[band] = omp_get_wtime() - band_start;
         }
     }
+    omp_set_schedule(schedule_kind, schedule_chunk);
+    periodicity_stats = {retired, saved_iterations};
+    refill_stats = {busy_lanes, total_lanes};
+    if (cost_partition) {
+        partition_stats.measured = CostMap::imbalance(band_time);
+    }
     return data;
-}
\ No newline at end of file
+}
+
+template <typename T, typename E>
+void BatchMandelCalculator<T, E>::report(std::ostream &cout, bool batchMode) {
+    BaseMandelCalculator::report(cout, batchMode);
+    if (batchMode) {
+        return;
+    }
+    reportPlacement(cout, data);
+    if (cost_partition) {
+        cout << "Cost partition:    " << partition_stats.bands << " bands, probe " << partition_stats.probeTime << " ms" << endl;
+        cout << "Band imbalance:    " << 100.0 * partition_stats.predicted << " % predicted ("
+             << 100.0 * partition_stats.equalLines << " % for equal line counts), "
+             << 100.0 * partition_stats.measured << " % measured" << endl;
+    }
+    if (periodicity) {
+        cout << "Periodic cells:    " << periodicity_stats.retired << " retired early, "
+             << periodicity_stats.savedIterations << " iterations saved" << endl;
+    }
+    if (refill) {
+        cout << "Lane occupancy:    "
+             << (refill_stats.totalLanes ? 100.0 * refill_stats.busyLanes / refill_stats.totalLanes : 0.0) << " %" << endl;
+    }
+}
+
+template class BatchMandelCalculator<float, uint8_t>;
+template class BatchMandelCalculator<float, uint16_t>;
+template class BatchMandelCalculator<float, int>;
+template class BatchMandelCalculator<double, uint8_t>;
+template class BatchMandelCalculator<double, uint16_t>;
+template class BatchMandelCalculator<double, int>;
@@ -8,20 +8,50 @@
 #define BATCHMANDELCALCULATOR_H
 
 #include <BaseMandelCalculator.h>
+#include "BatchMandelKernel.h"
+#include "CostMap.h"
 
+/**
+ * @tparam T floating point type to iterate in (float or double)
+ * @tparam E element type of the iteration counts (uint8_t, uint16_t or int), has to hold limit
+ */
+template <typename T, typename E = int>
 class BatchMandelCalculator : public BaseMandelCalculator
 {
 public:
-    BatchMandelCalculator(unsigned matrixBaseSize, unsigned limit);
+    /**
+     * @param periodicity retire the cells whose orbit turns out to be periodic before reaching limit
+     * @param refill keep every lane busy by refilling it with the next pending cell once its cell is done
+     * @param streams number of independent streams interleaved by the kernel (1 to MAX_STREAMS)
+     * @param costPartition give every thread one band of lines of equal cost predicted by a CostMap probe
+     */
+    BatchMandelCalculator(unsigned matrixBaseSize, unsigned limit, bool periodicity = false, bool refill = false,
+                          int streams = 1, bool costPartition = false);
     ~BatchMandelCalculator();
-    int * calculateMandelbrot();
+    E * calculateMandelbrot();
+    void report(std::ostream &cout, bool batchMode);
 
 private:
-    int* data;
-    float* z_x_temp;
-    float* z_y_temp;
+    E* data;
+    int scratch_stride;         // cells of the helper arrays per thread, thread t uses [t * scratch_stride, ...)
+    T* z_x_temp;
+    T* z_y_temp;
+    int* line_temp;             // lines the counts of a narrow matrix are calculated in, see countLine
+    int line_stride;            // cells of line_temp per thread
+    T* saved_x_temp;            // saved orbit points of the periodicity check
+    T* saved_y_temp;
     int half_height;
+    int first_row;      // first calculated line, see BaseMandelCalculator::calculatedFirstRow
+    bool cost_partition;
+    PartitionStats partition_stats;
+    bool periodicity;
+    PeriodicityStats periodicity_stats;
+    bool refill;
+    RefillStats refill_stats;
     unsigned matrix_base_size;
+    decltype(&isa_sse42::calculateBatchLine<T>) kernel;  // line kernel compiled for the selected ISA
+    decltype(&isa_sse42::calculateBatchLinePeriodic<T>) periodic_kernel;
+    decltype(&isa_sse42::calculateBatchLineRefill<T>) refill_kernel;
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,421 @@
+/**
+ * @file BatchMandelKernel.cc
+ * @author Matěj Konopík <xkonop03@stud.fit.vutbr.cz>
+ * @brief Vectorized kernel of the batch calculator, compiled once per supported ISA
+ * @date 16.10.2026
+ */
+
+#include "BatchMandelKernel.h"
+
+#ifndef MANDEL_ISA_NS
+#error "Kernels are compiled through the per-ISA object libraries only"
+#endif
+
+namespace MANDEL_ISA_NS {
+
+/**
+ * @brief Runs one iteration of one cell of the batch
+ *
+ * The body has no branches, so that the loops calling it vectorize: the next z is calculated for every cell
+ * and kept by the pending cells that did not escape only, the escaped ones select their iteration instead.
+ * The cell has to lie in the line.
+ */
+template <typename T>
+static inline void iterateBatchCell(int *line, T *z_x, T *z_y, const T *c_x, T y_value,
+                                    int batch_start_index, int batch_inner_index, int iteration) {
+    const int x_index = batch_start_index + batch_inner_index;
+
+    const T z_x_value = z_x[batch_inner_index];
+    const T z_y_value = z_y[batch_inner_index];
+    const T x_value = c_x[batch_inner_index];
+
+    const T z_x2 = z_x_value * z_x_value;
+    const T z_y2 = z_y_value * z_y_value;
+
+    const bool pending = line[x_index] == CELL_PENDING;
+    const bool escaped = z_x2 + z_y2 > T(4);
+    const bool iterating = pending && !escaped;
+
+    line[x_index] = selectInt(pending && escaped, iteration, line[x_index]);
+    z_y[batch_inner_index] = iterating ? T(2) * z_x_value * z_y_value + y_value : z_y_value;
+    z_x[batch_inner_index] = iterating ? z_x2 - z_y2 + x_value : z_x_value;
+}
+
+/**
+ * @brief Fills the helper arrays from offset on with the batch of the line starting at batch_start_index
+ *
+ * @return false when the batch has no cell left to calculate, the helper arrays are not filled then
+ */
+template <typename T>
+static inline bool fillBatch(const int *line, T *z_x, T *z_y, T *c_x, T y_value, double x_start, double dx,
+                             int batch_start_index, int batch_size, int offset) {
+    int pending = 0;
+#pragma omp simd simdlen(simdLen<int>()) reduction(+:pending)
+    for (int batch_inner_index = 0; batch_inner_index < batch_size; batch_inner_index++) {
+        pending += line[batch_start_index + batch_inner_index] == CELL_PENDING;
+    }
+    if (!pending) return false;
+
+#pragma omp simd simdlen(simdLen<T>())
+    for (int batch_inner_index = 0; batch_inner_index < batch_size; batch_inner_index++) {
+        c_x[offset + batch_inner_index] = T(x_start + (batch_start_index + batch_inner_index) * dx);
+        z_x[offset + batch_inner_index] = c_x[offset + batch_inner_index];
+        z_y[offset + batch_inner_index] = y_value;
+    }
+    return true;
+}
+
+template <typename T, int STREAMS>
+void calculateBatchLine(int *line, T *z_x, T *z_y, T y_value,
+                        double x_start, double dx, int width, int limit) {
+    static_assert(STREAMS >= 1 && STREAMS <= MAX_STREAMS, "Unsupported number of interleaved streams");
+    // cells of the whole batches of the line
+    const int whole_width = width - width % BATCH_SIZE;
+    // real parts of the points of the group, converted once instead of in every iteration
+    alignas(64) T c_x[MAX_STREAMS * BATCH_SIZE];
+
+    // a group are the next STREAMS batches with a cell left to calculate, not necessarily adjacent ones, as every
+    // batch is iterated to the limit and must not be calculated only because its neighbour is
+    int batch_start_index = 0;
+    while (true) {
+        // the cell s * BATCH_SIZE + i of the helper arrays is the cell group_start[s] + i of the line
+        int group_start[MAX_STREAMS];
+        int streams = 0;
+        for (; batch_start_index < whole_width && streams < STREAMS; batch_start_index += BATCH_SIZE) {
+            if (fillBatch(line, z_x, z_y, c_x, y_value, x_start, dx,
+                          batch_start_index, BATCH_SIZE, streams * BATCH_SIZE)) {
+                group_start[streams] = batch_start_index - streams * BATCH_SIZE;
+                streams++;
+            }
+        }
+        if (!streams) break;
+
+        // calculate the mandelbrot values for the current group, every loop trip advances one vector of each batch
+        for (int iteration = 0; iteration < limit; iteration++) {
+            if (streams == STREAMS) {
+                // cycle over the helper arrays and calculate
+#pragma omp simd simdlen(simdLen<T>())
+                for (int batch_inner_index = 0; batch_inner_index < BATCH_SIZE; batch_inner_index++) {
+                    iterateBatchCell(line, z_x, z_y, c_x, y_value,
+                                     group_start[0], batch_inner_index, iteration);
+                    if (STREAMS > 1)
+                        iterateBatchCell(line, z_x, z_y, c_x, y_value,
+                                         group_start[1], batch_inner_index + BATCH_SIZE, iteration);
+                    if (STREAMS > 2)
+                        iterateBatchCell(line, z_x, z_y, c_x, y_value,
+                                         group_start[2], batch_inner_index + 2 * BATCH_SIZE, iteration);
+                    if (STREAMS > 3)
+                        iterateBatchCell(line, z_x, z_y, c_x, y_value,
+                                         group_start[3], batch_inner_index + 3 * BATCH_SIZE, iteration);
+                }
+            } else {
+                // the line ran out of batches before the group was full, its batches are iterated one by one
+                for (int stream = 0; stream < streams; stream++) {
+#pragma omp simd simdlen(simdLen<T>())
+                    for (int batch_inner_index = stream * BATCH_SIZE; batch_inner_index < (stream + 1) * BATCH_SIZE;
+                         batch_inner_index++) {
+                        iterateBatchCell(line, z_x, z_y, c_x, y_value,
+                                         group_start[stream], batch_inner_index, iteration);
+                    }
+                }
+            }
+        }
+    }
+
+    // the last batch of the line may be shorter, it is iterated on its own
+    const int batch_size = width - whole_width;
+    if (batch_size && fillBatch(line, z_x, z_y, c_x, y_value, x_start, dx, whole_width, batch_size, 0)) {
+        for (int iteration = 0; iteration < limit; iteration++) {
+#pragma omp simd simdlen(simdLen<T>())
+            for (int batch_inner_index = 0; batch_inner_index < batch_size; batch_inner_index++) {
+                iterateBatchCell(line, z_x, z_y, c_x, y_value, whole_width, batch_inner_index, iteration);
+            }
+        }
+    }
+
+    // the cells that did not escape are in the set
+#pragma omp simd simdlen(simdLen<int>())
+    for (int x_index = 0; x_index < width; x_index++) {
+        line[x_index] = line[x_index] == CELL_PENDING ? limit : line[x_index];
+    }
+}
+
+template <typename T>
+PeriodicityStats calculateBatchLinePeriodic(int *line, T *z_x, T *z_y, T *saved_x, T *saved_y, T y_value,
+                                            double x_start, double dx, int width, int limit) {
+    const T tolerance = periodicityTolerance<T>();
+    PeriodicityStats stats = {0, 0};
+
+    // iterate over the batches in the current line
+    for (int batch_start_index = 0; batch_start_index < width; batch_start_index += BATCH_SIZE) {
+        // the last batch of the line may be shorter
+        const int batch_size = width - batch_start_index < BATCH_SIZE ? width - batch_start_index : BATCH_SIZE;
+
+        // fill up the helper arrays with the current batch values, the starting point is the first saved one
+#pragma omp simd simdlen(simdLen<T>())
+        for (int batch_inner_index = 0; batch_inner_index < batch_size; batch_inner_index++) {
+            z_x[batch_inner_index] = T(x_start + (batch_start_index + batch_inner_index) * dx);
+            z_y[batch_inner_index] = y_value;
+            saved_x[batch_inner_index] = z_x[batch_inner_index];
+            saved_y[batch_inner_index] = y_value;
+        }
+
+        // calculate the mandelbrot values for the current batch, saving the orbit points at powers of two
+        int next_save = 1;
+        for (int iteration = 0; iteration < limit; iteration++) {
+            const bool save = iteration == next_save;
+            if (save) next_save *= 2;
+
+            // number of cells that are still iterating, the batch is done once there are none
+            int active = 0;
+            int retired = 0;
+#pragma omp simd simdlen(simdLen<T>()) reduction(+:active, retired)
+            for (int batch_inner_index = 0; batch_inner_index < batch_size; batch_inner_index++) {
+                const int x_index = batch_start_index + batch_inner_index;
+                const T x_value = T(x_start + x_index * dx);
+
+                const T z_x_value = z_x[batch_inner_index];
+                const T z_y_value = z_y[batch_inner_index];
+
+                const T z_x2 = z_x_value * z_x_value;
+                const T z_y2 = z_y_value * z_y_value;
+                const T new_y = T(2) * z_x_value * z_y_value + y_value;
+                const T new_x = z_x2 - z_y2 + x_value;
+                const T saved_x_value = saved_x[batch_inner_index];
+                const T saved_y_value = saved_y[batch_inner_index];
+                const T diff_x = new_x - saved_x_value;
+                const T diff_y = new_y - saved_y_value;
+
+                const bool pending = line[x_index] == CELL_PENDING;
+                const bool escaped = z_x2 + z_y2 > T(4);
+                // the orbit came back to the saved point, it will never escape
+                const bool periodic = diff_x < tolerance && diff_x > -tolerance
+                                      && diff_y < tolerance && diff_y > -tolerance;
+                const bool stepped = pending && !escaped;
+                const bool iterating = stepped && !periodic;
+
+                line[x_index] = selectInt(pending && escaped, iteration,
+                                          selectInt(stepped && periodic, limit, line[x_index]));
+                z_y[batch_inner_index] = stepped ? new_y : z_y_value;
+                z_x[batch_inner_index] = stepped ? new_x : z_x_value;
+                saved_y[batch_inner_index] = iterating && save ? new_y : saved_y_value;
+                saved_x[batch_inner_index] = iterating && save ? new_x : saved_x_value;
+                retired += stepped && periodic;
+                active += iterating;
+            }
+            stats.retired += retired;
+            stats.savedIterations += (long) retired * (limit - iteration - 1);
+            if (!active) break;
+        }
+    }
+
+    // the cells that did not escape are in the set
+#pragma omp simd simdlen(simdLen<int>())
+    for (int x_index = 0; x_index < width; x_index++) {
+        line[x_index] = line[x_index] == CELL_PENDING ? limit : line[x_index];
+    }
+    return stats;
+}
+
+template <typename T>
+RefillStats calculateBatchLineRefill(int *line, T *z_x, T *z_y, T y_value,
+                                     double x_start, double dx, int width, int limit) {
+    // lane states
+    const int LANE_ITERATING = 0;
+    const int LANE_FINISHED = 1;
+    const int LANE_EMPTY = 2;
+
+    alignas(64) T c_x[BATCH_SIZE];
+    alignas(64) int lane_cell[BATCH_SIZE];
+    alignas(64) int lane_iteration[BATCH_SIZE];
+    alignas(64) int lane_state[BATCH_SIZE];
+    RefillStats stats = {0, 0};
+
+    // all the lanes start empty and take their first cell in the first refill
+    int next_cell = 0;
+    // the lanes without a cell are stepped along with the others (and ignored), on the point 0
+    for (int lane = 0; lane < BATCH_SIZE; lane++) {
+        lane_state[lane] = LANE_EMPTY;
+        c_x[lane] = T(0);
+        z_x[lane] = T(0);
+        z_y[lane] = T(0);
+    }
+
+    while (true) {
+        // write the finished cells and refill their lanes with the next pending cells of the line
+        int busy = 0;
+        for (int lane = 0; lane < BATCH_SIZE; lane++) {
+            if (lane_state[lane] == LANE_FINISHED) {
+                line[lane_cell[lane]] = lane_iteration[lane];
+                lane_state[lane] = LANE_EMPTY;
+            }
+            if (lane_state[lane] == LANE_EMPTY) {
+                while (next_cell < width && line[next_cell] != CELL_PENDING) {
+                    next_cell++;
+                }
+                if (next_cell < width) {
+                    lane_cell[lane] = next_cell;
+                    c_x[lane] = T(x_start + next_cell * dx);
+                    z_x[lane] = c_x[lane];
+                    z_y[lane] = y_value;
+                    lane_iteration[lane] = 0;
+                    lane_state[lane] = LANE_ITERATING;
+                    next_cell++;
+                }
+            }
+            busy += lane_state[lane] == LANE_ITERATING;
+        }
+        if (!busy) break;
+
+        // iterate all the lanes, each on its own cell
+        for (int step = 0; step < REFILL_INTERVAL; step++) {
+            int active = 0;
+#pragma omp simd simdlen(simdLen<T>()) reduction(+:active)
+            for (int lane = 0; lane < BATCH_SIZE; lane++) {
+                const T z_x_value = z_x[lane];
+                const T z_y_value = z_y[lane];
+                const T c_x_value = c_x[lane];
+
+                const T z_x2 = z_x_value * z_x_value;
+                const T z_y2 = z_y_value * z_y_value;
+
+                const int state = lane_state[lane];
+                const bool busy_lane = state == LANE_ITERATING;
+                const bool escaped = z_x2 + z_y2 > T(4);
+                const bool iterating = busy_lane && !escaped;
+                const int next_iteration = lane_iteration[lane] + iterating;
+
+                z_y[lane] = iterating ? T(2) * z_x_value * z_y_value + y_value : z_y_value;
+                z_x[lane] = iterating ? z_x2 - z_y2 + c_x_value : z_x_value;
+                lane_iteration[lane] = next_iteration;
+                // the cells that did not escape are in the set, the conditions are combined without short-circuiting,
+                // which would be a branch again
+                const bool finished = busy_lane & (escaped | (next_iteration == limit));
+                lane_state[lane] = selectInt(finished, LANE_FINISHED, state);
+                active += busy_lane;
+            }
+            stats.busyLanes += active;
+            stats.totalLanes += BATCH_SIZE;
+        }
+    }
+    return stats;
+}
+
+template <typename T>
+void calculateBatchCells(int *line, const int *cells, int count, T *z_x, T *z_y, T y_value,
+                         double x_start, double dx, int limit) {
+    alignas(64) int batch_result[BATCH_SIZE];
+
+    // iterate over the batches of the listed cells
+    for (int batch_start_index = 0; batch_start_index < count; batch_start_index += BATCH_SIZE) {
+        const int batch_size = count - batch_start_index < BATCH_SIZE ? count - batch_start_index : BATCH_SIZE;
+        const int *batch_cells = cells + batch_start_index;
+
+        // fill up the helper arrays with the current batch values
+#pragma omp simd simdlen(simdLen<T>())
+        for (int batch_inner_index = 0; batch_inner_index < batch_size; batch_inner_index++) {
+            z_x[batch_inner_index] = T(x_start + batch_cells[batch_inner_index] * dx);
+            z_y[batch_inner_index] = y_value;
+            batch_result[batch_inner_index] = limit;
+        }
+
+        // calculate the mandelbrot values for the current batch
+        for (int iteration = 0; iteration < limit; iteration++) {
+            // number of cells that are still iterating, the batch is done once there are none
+            int active = 0;
+#pragma omp simd simdlen(simdLen<T>()) reduction(+:active)
+            for (int batch_inner_index = 0; batch_inner_index < batch_size; batch_inner_index++) {
+                const T x_value = T(x_start + batch_cells[batch_inner_index] * dx);
+
+                const T z_x_value = z_x[batch_inner_index];
+                const T z_y_value = z_y[batch_inner_index];
+
+                const T z_x2 = z_x_value * z_x_value;
+                const T z_y2 = z_y_value * z_y_value;
+
+                const bool pending = batch_result[batch_inner_index] == limit;
+                const bool escaped = z_x2 + z_y2 > T(4);
+                const bool iterating = pending && !escaped;
+
+                batch_result[batch_inner_index] = selectInt(pending && escaped, iteration,
+                                                            batch_result[batch_inner_index]);
+                z_y[batch_inner_index] = iterating ? T(2) * z_x_value * z_y_value + y_value : z_y_value;
+                z_x[batch_inner_index] = iterating ? z_x2 - z_y2 + x_value : z_x_value;
+                active += iterating;
+            }
+            if (!active) break;
+        }
+
+        // scatter the results back to the line
+        for (int batch_inner_index = 0; batch_inner_index < batch_size; batch_inner_index++) {
+            line[batch_cells[batch_inner_index]] = batch_result[batch_inner_index];
+        }
+    }
+}
+
+template <typename T>
+void calculateBatchPoints(int *result, const T *c_x, const T *c_y, int count, T *z_x, T *z_y, int limit) {
+    // iterate over the batches of the points
+    for (int batch_start_index = 0; batch_start_index < count; batch_start_index += BATCH_SIZE) {
+        const int batch_size = count - batch_start_index < BATCH_SIZE ? count - batch_start_index : BATCH_SIZE;
+        int *batch_result = result + batch_start_index;
+        const T *batch_c_x = c_x + batch_start_index;
+        const T *batch_c_y = c_y + batch_start_index;
+
+        // fill up the helper arrays with the current batch values
+#pragma omp simd simdlen(simdLen<T>())
+        for (int batch_inner_index = 0; batch_inner_index < batch_size; batch_inner_index++) {
+            z_x[batch_inner_index] = batch_c_x[batch_inner_index];
+            z_y[batch_inner_index] = batch_c_y[batch_inner_index];
+            batch_result[batch_inner_index] = limit;
+        }
+
+        // calculate the mandelbrot values for the current batch
+        for (int iteration = 0; iteration < limit; iteration++) {
+            // number of points that are still iterating, the batch is done once there are none
+            int active = 0;
+#pragma omp simd simdlen(simdLen<T>()) reduction(+:active)
+            for (int batch_inner_index = 0; batch_inner_index < batch_size; batch_inner_index++) {
+                const T z_x_value = z_x[batch_inner_index];
+                const T z_y_value = z_y[batch_inner_index];
+                const T c_x_value = batch_c_x[batch_inner_index];
+                const T c_y_value = batch_c_y[batch_inner_index];
+
+                const T z_x2 = z_x_value * z_x_value;
+                const T z_y2 = z_y_value * z_y_value;
+
+                const bool pending = batch_result[batch_inner_index] == limit;
+                const bool escaped = z_x2 + z_y2 > T(4);
+                const bool iterating = pending && !escaped;
+
+                batch_result[batch_inner_index] = selectInt(pending && escaped, iteration,
+                                                            batch_result[batch_inner_index]);
+                z_y[batch_inner_index] = iterating ? T(2) * z_x_value * z_y_value + c_y_value : z_y_value;
+                z_x[batch_inner_index] = iterating ? z_x2 - z_y2 + c_x_value : z_x_value;
+                active += iterating;
+            }
+            if (!active) break;
+        }
+    }
+}
+
+template void calculateBatchLine<float, 1>(int *, float *, float *, float, double, double, int, int);
+template void calculateBatchLine<float, 2>(int *, float *, float *, float, double, double, int, int);
+template void calculateBatchLine<float, 3>(int *, float *, float *, float, double, double, int, int);
+template void calculateBatchLine<float, 4>(int *, float *, float *, float, double, double, int, int);
+template void calculateBatchLine<double, 1>(int *, double *, double *, double, double, double, int, int);
+template void calculateBatchLine<double, 2>(int *, double *, double *, double, double, double, int, int);
+template void calculateBatchLine<double, 3>(int *, double *, double *, double, double, double, int, int);
+template void calculateBatchLine<double, 4>(int *, double *, double *, double, double, double, int, int);
+template PeriodicityStats calculateBatchLinePeriodic<float>(int *, float *, float *, float *, float *, float,
+                                                            double, double, int, int);
+template PeriodicityStats calculateBatchLinePeriodic<double>(int *, double *, double *, double *, double *, double,
+                                                             double, double, int, int);
+template RefillStats calculateBatchLineRefill<float>(int *, float *, float *, float, double, double, int, int);
+template RefillStats calculateBatchLineRefill<double>(int *, double *, double *, double, double, double, int, int);
+template void calculateBatchCells<float>(int *, const int *, int, float *, float *, float, double, double, int);
+template void calculateBatchCells<double>(int *, const int *, int, double *, double *, double, double, double, int);
+template void calculateBatchPoints<float>(int *, const float *, const float *, int, float *, float *, int);
+template void calculateBatchPoints<double>(int *, const double *, const double *, int, double *, double *, int);
+
+}
@@ -0,0 +1,96 @@
+/**
+ * @file BatchMandelKernel.h
+ * @author Matěj Konopík <xkonop03@stud.fit.vutbr.cz>
+ * @brief Vectorized kernel of the batch calculator, compiled once per supported ISA
+ * @date 16.10.2026
+ */
+#ifndef BATCHMANDELKERNEL_H
+#define BATCHMANDELKERNEL_H
+
+#include "isa_dispatch.h"
+#include "ClassifierKernel.h"
+#include "PeriodicityCheck.h"
+
+#define BATCH_SIZE 64                           // number of cells to calculate in one batch
+#define REFILL_INTERVAL 4                       // iterations between two refills of the persistent lanes
+
+/**
+ * @brief Lane counters of the refill mode of the batch kernel, summed over the iterations
+ */
+struct RefillStats {
+    long busyLanes;                             // lanes iterating a cell
+    long totalLanes;                            // lanes available
+};
+
+ISA_DECLARE(
+    /**
+     * @brief Calculates one line of the set, batch by batch
+     *
+     * Every batch with a cell left is iterated up to the limit, STREAMS of them at once.
+     *
+     * @param line output line (width cells), only its CELL_PENDING cells are calculated
+     * @param z_x helper array for the real parts (STREAMS * BATCH_SIZE cells)
+     * @param z_y helper array for the imaginary parts (STREAMS * BATCH_SIZE cells)
+     * @tparam T floating point type to iterate in
+     * @tparam STREAMS number of batches interleaved in one loop trip (1 to MAX_STREAMS)
+     */
+    template <typename T, int STREAMS = 1>
+    void calculateBatchLine(int *line, T *z_x, T *z_y, T y_value,
+                            double x_start, double dx, int width, int limit);
+
+    /**
+     * @brief Calculates one line of the set like calculateBatchLine, retiring the cells whose orbit is periodic
+     *
+     * A batch stops iterating once all of its cells escaped or were retired, see calculateLinePeriodic.
+     *
+     * @param saved_x helper array for the real parts of the saved orbit points (BATCH_SIZE cells)
+     * @param saved_y helper array for the imaginary parts of the saved orbit points (BATCH_SIZE cells)
+     * @return number of retired cells and iterations saved by retiring them
+     */
+    template <typename T>
+    PeriodicityStats calculateBatchLinePeriodic(int *line, T *z_x, T *z_y, T *saved_x, T *saved_y, T y_value,
+                                                double x_start, double dx, int width, int limit);
+
+    /**
+     * @brief Calculates one line of the set with persistent lanes refilled from the line's pending cells
+     *
+     * Every lane iterates its own cell, once the cell escapes or reaches limit its value is written and
+     * the lane takes the next pending cell of the line, so the lanes stay busy until the line is done.
+     *
+     * @param line output line (width cells), only its CELL_PENDING cells are calculated
+     * @param z_x helper array for the real parts (BATCH_SIZE cells)
+     * @param z_y helper array for the imaginary parts (BATCH_SIZE cells)
+     * @return lane occupancy counters
+     */
+    template <typename T>
+    RefillStats calculateBatchLineRefill(int *line, T *z_x, T *z_y, T y_value,
+                                         double x_start, double dx, int width, int limit);
+
+    /**
+     * @brief Calculates the listed cells of one line, batch by batch
+     *
+     * @param line output line, only the listed cells are written
+     * @param cells indices of the cells to calculate (count cells)
+     * @param z_x helper array for the real parts (BATCH_SIZE cells)
+     * @param z_y helper array for the imaginary parts (BATCH_SIZE cells)
+     * @tparam T floating point type to iterate in
+     */
+    template <typename T>
+    void calculateBatchCells(int *line, const int *cells, int count, T *z_x, T *z_y, T y_value,
+                             double x_start, double dx, int limit);
+
+    /**
+     * @brief Calculates arbitrary points of the plane, batch by batch
+     *
+     * @param result output values of the points (count cells)
+     * @param c_x real parts of the points (count cells)
+     * @param c_y imaginary parts of the points (count cells)
+     * @param z_x helper array for the real parts (BATCH_SIZE cells)
+     * @param z_y helper array for the imaginary parts (BATCH_SIZE cells)
+     * @tparam T floating point type to iterate in
+     */
+    template <typename T>
+    void calculateBatchPoints(int *result, const T *c_x, const T *c_y, int count, T *z_x, T *z_y, int limit);
+)
+
+#endif
@@ -0,0 +1,255 @@
+/**
+ * @file BoundaryTraceMandelCalculator.cc
+ * @author Matěj Konopík <xkonop03@stud.fit.vutbr.cz>
+ * @brief Mandelbrot calculator tracing the contours between the iteration count regions and flood filling them
+ * @date 16.10.2026
+ */
+
+#include <iostream>
+#include <cstdlib>
+#include <cstring>
+
+#include "BoundaryTraceMandelCalculator.h"
+
+using std::cout;
+using std::cerr;
+using std::endl;
+
+#define ALIGN_SIZE 64                           // align memory to 64 bytes (for the AVX512 registers: 64B = 512b)
+#define TRACE_QUEUE_SIZE 4096                   // number of cells evaluated by one kernel call at most
+#define CELL_QUEUED (-2)                        // marks the cells waiting for the kernel
+#define TRACE_MEM_ALLOC_ERR 7000                // error code for memory allocation failure
+
+
+//#define DEBUG   // uncomment this line to enable debug printing
+#ifdef DEBUG
+#define D_PRINT(x) std::cout << "TRACE_DEBUG: " << x << std::endl
+#else
+#define D_PRINT(x)
+#endif
+
+
+template <typename T>
+BoundaryTraceMandelCalculator<T>::BoundaryTraceMandelCalculator(unsigned matrixBaseSize, unsigned limit) :
+        BaseMandelCalculator(matrixBaseSize, limit, std::string("BoundaryTraceMandelCalculator<") + precisionName<T>() + ">"),
+        cell_count(0), evaluated(0) {
+    // pick the kernel compiled for the ISA selected at startup
+    kernel = ISA_DISPATCH(selectedIsa(), calculateBatchPoints<T>);
+    isaVariant = isaName(selectedIsa());
+    // we use the fact that mandelbrot is symmetrical, therefore we only calculate half and then copy it
+    half_height = calculatedHeight();
+    first_row = calculatedFirstRow();
+    // allocate main data matrix
+    data = (int *) (aligned_alloc(ALIGN_SIZE, height * width * sizeof(int)));
+    // allocate helper arrays
+    visited = (uint64_t *) (aligned_alloc(ALIGN_SIZE, ((width * half_height + 511) / 512) * ALIGN_SIZE));
+    cells = (int *) (aligned_alloc(ALIGN_SIZE, TRACE_QUEUE_SIZE * sizeof(int)));
+    cell_values = (int *) (aligned_alloc(ALIGN_SIZE, TRACE_QUEUE_SIZE * sizeof(int)));
+    c_x_temp = (T *) (aligned_alloc(ALIGN_SIZE, TRACE_QUEUE_SIZE * sizeof(T)));
+    c_y_temp = (T *) (aligned_alloc(ALIGN_SIZE, TRACE_QUEUE_SIZE * sizeof(T)));
+    z_x_temp = (T *) (aligned_alloc(ALIGN_SIZE, BATCH_SIZE * sizeof(T)));
+    z_y_temp = (T *) (aligned_alloc(ALIGN_SIZE, BATCH_SIZE * sizeof(T)));
+    // check allocation success
+    if (data == nullptr or visited == nullptr or cells == nullptr or cell_values == nullptr or
+        c_x_temp == nullptr or c_y_temp == nullptr or z_x_temp == nullptr or z_y_temp == nullptr) {
+        cerr << typeid(*this).name() << " : Memory allocation failed. Aborting." << endl;
+        exit(TRACE_MEM_ALLOC_ERR);
+    }
+    D_PRINT(typeid(*this).name() << " : half_height=" << half_height
+                                 << " height=" << height
+                                 << " width=" << width
+                                 << " limit=" << limit
+                                 << endl);
+}
+
+template <typename T>
+BoundaryTraceMandelCalculator<T>::~BoundaryTraceMandelCalculator() {
+    // free allocated data with checking against the memory validity
+    if (data != nullptr) {
+        free(data);
+    }
+    if (visited != nullptr) {
+        free(visited);
+    }
+    if (cells != nullptr) {
+        free(cells);
+    }
+    if (cell_values != nullptr) {
+        free(cell_values);
+    }
+    if (c_x_temp != nullptr) {
+        free(c_x_temp);
+    }
+    if (c_y_temp != nullptr) {
+        free(c_y_temp);
+    }
+    if (z_x_temp != nullptr) {
+        free(z_x_temp);
+    }
+    if (z_y_temp != nullptr) {
+        free(z_y_temp);
+    }
+}
+
+
+template <typename T>
+void BoundaryTraceMandelCalculator<T>::queueCell(int index) {
+    if (data[index] != CELL_PENDING) {
+        return;
+    }
+    data[index] = CELL_QUEUED;
+    cells[cell_count] = index;
+    c_x_temp[cell_count] = T(x_start + (index % width) * dx);
+    c_y_temp[cell_count] = T(yValue(index / width));
+    if (++cell_count == TRACE_QUEUE_SIZE) {
+        evaluateQueued();
+    }
+}
+
+template <typename T>
+void BoundaryTraceMandelCalculator<T>::evaluateQueued() {
+    if (cell_count == 0) {
+        return;
+    }
+    kernel(cell_values, c_x_temp, c_y_temp, cell_count, z_x_temp, z_y_temp, limit);
+    for (auto i = 0; i < cell_count; i++) {
+        data[cells[i]] = cell_values[i];
+    }
+    evaluated += cell_count;
+    cell_count = 0;
+}
+
+template <typename T>
+void BoundaryTraceMandelCalculator<T>::visitCell(int index) {
+    const int visited_index = index - first_row * width;
+    uint64_t &word = visited[visited_index / 64];
+    const uint64_t bit = uint64_t(1) << (visited_index % 64);
+    if (word & bit) {
+        return;
+    }
+    word |= bit;
+    next_frontier.push_back(index);
+}
+
+template <typename T>
+int BoundaryTraceMandelCalculator<T>::neighbours(int index, int *out) const {
+    const int x_index = index % width;
+    const int y_index = index / width;
+    int count = 0;
+    if (x_index > 0) out[count++] = index - 1;
+    if (x_index + 1 < width) out[count++] = index + 1;
+    if (y_index > first_row) out[count++] = index - width;
+    if (y_index + 1 < first_row + half_height) out[count++] = index + width;
+    return count;
+}
+
+
+template <typename T>
+int *BoundaryTraceMandelCalculator<T>::calculateMandelbrot() {
+    resetPrepared();
+    evaluated = 0;
+
+    // mark the lines not mirrored from other ones as not calculated yet (or classify them)
+    for (auto y_index = first_row; y_index < first_row + half_height; y_index++) {
+        prepareLine(data + y_index * width, y_index);
+    }
+    memset(visited, 0, ((width * half_height + 511) / 512) * ALIGN_SIZE);
+
+    // the contours start from the border of the calculated lines
+    next_frontier.clear();
+    for (auto x_index = 0; x_index < width; x_index++) {
+        visitCell(first_row * width + x_index);
+        visitCell((first_row + half_height - 1) * width + x_index);
+    }
+    for (auto y_index = first_row + 1; y_index < first_row + half_height - 1; y_index++) {
+        visitCell(y_index * width);
+        visitCell(y_index * width + width - 1);
+    }
+    for (auto index : next_frontier) {
+        queueCell(index);
+    }
+    evaluateQueued();
+
+    // trace the contours wave by wave, every wave is evaluated by the kernel at once
+    int adjacent[4];
+    while (not next_frontier.empty()) {
+        frontier.swap(next_frontier);
+        next_frontier.clear();
+
+        // evaluate all the neighbours of the frontier
+        for (auto index : frontier) {
+            const int count = neighbours(index, adjacent);
+            for (auto i = 0; i < count; i++) {
+                queueCell(adjacent[i]);
+            }
+        }
+        evaluateQueued();
+
+        // a cell differing from its neighbour lies on a contour together with it, the neighbours of both
+        // are checked next, so that the trace follows the contour (along which the values do not change)
+        int across[4];
+        for (auto index : frontier) {
+            const int count = neighbours(index, adjacent);
+            for (auto i = 0; i < count; i++) {
+                if (data[adjacent[i]] == data[index]) {
+                    continue;
+                }
+                for (auto j = 0; j < count; j++) {
+                    visitCell(adjacent[j]);
+                }
+                const int across_count = neighbours(adjacent[i], across);
+                for (auto j = 0; j < across_count; j++) {
+                    visitCell(across[j]);
+                }
+            }
+        }
+    }
+    D_PRINT("evaluated: " << evaluated);
+
+    // the cells left form regions enclosed by a contour of a single value, flood fill every region with it
+    for (auto y_index = first_row; y_index < first_row + half_height; y_index++) {
+        for (auto x_index = 1; x_index < width; x_index++) {
+            const int start = y_index * width + x_index;
+            if (data[start] != CELL_PENDING) {
+                continue;
+            }
+            // the first cell of a region in the line order has its left neighbour on the enclosing contour
+            const int value = data[start - 1];
+            data[start] = value;
+            frontier.assign(1, start);
+            while (not frontier.empty()) {
+                const int index = frontier.back();
+                frontier.pop_back();
+                const int count = neighbours(index, adjacent);
+                for (auto i = 0; i < count; i++) {
+                    if (data[adjacent[i]] == CELL_PENDING) {
+                        data[adjacent[i]] = value;
+                        frontier.push_back(adjacent[i]);
+                    }
+                }
+            }
+        }
+    }
+
+    // copy the calculated lines to the lines mirroring them across the real axis (a window is not mirrored)
+    mirrorLines(data);
+    return data;
+}
+
+template <typename T>
+void BoundaryTraceMandelCalculator<T>::report(std::ostream &cout, bool batchMode) {
+    BaseMandelCalculator::report(cout, batchMode);
+    if (batchMode) {
+        return;
+    }
+    cout << "Evaluated cells:   " << evaluated << " ("
+         << 100.0 * evaluated / ((long) half_height * width) << " % of the calculated lines)" << endl;
+}
+
+template <typename T>
+long BoundaryTraceMandelCalculator<T>::evaluatedCells() {
+    return evaluated;
+}
+
+template class BoundaryTraceMandelCalculator<float>;
+template class BoundaryTraceMandelCalculator<double>;
@@ -0,0 +1,70 @@
+/**
+ * @file BoundaryTraceMandelCalculator.h
+ * @author Matěj Konopík <xkonop03@stud.fit.vutbr.cz>
+ * @brief Mandelbrot calculator tracing the contours between the iteration count regions and flood filling them
+ * @date 16.10.2026
+ */
+#ifndef BOUNDARYTRACEMANDELCALCULATOR_H
+#define BOUNDARYTRACEMANDELCALCULATOR_H
+
+#include <vector>
+#include <cstdint>
+
+#include <BaseMandelCalculator.h>
+#include "BatchMandelKernel.h"
+
+/**
+ * @tparam T floating point type to iterate in (float or double)
+ */
+template <typename T>
+class BoundaryTraceMandelCalculator : public BaseMandelCalculator
+{
+public:
+    BoundaryTraceMandelCalculator(unsigned matrixBaseSize, unsigned limit);
+    ~BoundaryTraceMandelCalculator();
+    int *calculateMandelbrot();
+    void report(std::ostream &cout, bool batchMode);
+    long evaluatedCells();
+
+private:
+    int* data;
+    uint64_t* visited;          // bitmap of the cells that entered the frontier
+    int* cells;                 // indices of the cells waiting for the kernel
+    int* cell_values;
+    T* c_x_temp;                // coordinates of the cells waiting for the kernel
+    T* c_y_temp;
+    T* z_x_temp;
+    T* z_y_temp;
+    int cell_count;
+    int half_height;
+    int first_row;      // first calculated line, see BaseMandelCalculator::calculatedFirstRow
+    long evaluated;
+    std::vector<int> frontier;  // contour cells whose neighbours are to be checked
+    std::vector<int> next_frontier;
+
+    decltype(&isa_sse42::calculateBatchPoints<T>) kernel;  // point kernel compiled for the selected ISA
+
+    /**
+     * @brief Queues the cell for the kernel unless it is already known or queued
+     */
+    void queueCell(int index);
+
+    /**
+     * @brief Evaluates the queued cells and writes them to the matrix
+     */
+    void evaluateQueued();
+
+    /**
+     * @brief Adds the cell to the next frontier unless it has been there already
+     */
+    void visitCell(int index);
+
+    /**
+     * @brief Lists the 4-neighbours of the cell inside the calculated half
+     *
+     * @return number of the neighbours
+     */
+    int neighbours(int index, int *out) const;
+};
+
+#endif
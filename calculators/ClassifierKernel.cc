@@ -0,0 +1,39 @@
+/**
+ * @file ClassifierKernel.cc
+ * @author Matěj Konopík <xkonop03@stud.fit.vutbr.cz>
+ * @brief Vectorized closed-form interior/exterior classifier, compiled once per supported ISA
+ * @date 16.10.2026
+ */
+
+#include "ClassifierKernel.h"
+
+#ifndef MANDEL_ISA_NS
+#error "Kernels are compiled through the per-ISA object libraries only"
+#endif
+
+namespace MANDEL_ISA_NS {
+
+int classifyLine(int *line, double x_start, double dx, double y_value, int width, int limit) {
+    const double y_squared = y_value * y_value;
+    int resolved = 0;
+
+#pragma omp simd simdlen(simdLen<double>()) reduction(+:resolved)
+    for (int x_index = 0; x_index < width; x_index++) {
+        const double x_value = x_start + x_index * dx;
+
+        // main cardioid: q * (q + (x - 1/4)) <= y^2 / 4, q = (x - 1/4)^2 + y^2
+        const double q_x = x_value - 0.25;
+        const double q = q_x * q_x + y_squared;
+        const bool cardioid = q * (q + q_x) <= 0.25 * y_squared;
+        // period-2 bulb: (x + 1)^2 + y^2 <= 1/16
+        const bool bulb = (x_value + 1.0) * (x_value + 1.0) + y_squared <= 0.0625;
+        const bool outside = x_value * x_value + y_squared > 4.0;
+
+        const int value = outside ? 0 : (cardioid || bulb) ? limit : CELL_PENDING;
+        line[x_index] = value;
+        resolved += value != CELL_PENDING;
+    }
+    return resolved;
+}
+
+}
@@ -0,0 +1,28 @@
+/**
+ * @file ClassifierKernel.h
+ * @author Matěj Konopík <xkonop03@stud.fit.vutbr.cz>
+ * @brief Vectorized closed-form interior/exterior classifier, compiled once per supported ISA
+ * @date 16.10.2026
+ */
+#ifndef CLASSIFIERKERNEL_H
+#define CLASSIFIERKERNEL_H
+
+#include "isa_dispatch.h"
+
+#define CELL_PENDING (-1)                       // marks the cells the iteration kernels still have to calculate
+#define MAX_STREAMS 4                           // maximal number of interleaved streams of the line and batch kernels
+
+ISA_DECLARE(
+    /**
+     * @brief Resolves the cells of one line that do not need to be iterated
+     *
+     * Cells in the main cardioid or the period-2 bulb are set to limit, cells with |c| > 2 escape at
+     * iteration 0, all the others are set to CELL_PENDING.
+     *
+     * @param line output line (width cells)
+     * @return number of resolved cells
+     */
+    int classifyLine(int *line, double x_start, double dx, double y_value, int width, int limit);
+)
+
+#endif
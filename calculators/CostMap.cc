@@ -0,0 +1,100 @@
+/**
+ * @file CostMap.cc
+ * @author Matěj Konopík <xkonop03@stud.fit.vutbr.cz>
+ * @brief Predicted calculation cost of the lines from a low resolution probe, split into equal-cost bands
+ * @date 16.10.2026
+ */
+
+#include <algorithm>
+#include <chrono>
+
+#include "CostMap.h"
+#include "BatchMandelKernel.h"
+
+CostMap::CostMap(int width, int rows, double x_start, double dx, double y_start, double dy, int limit, int group,
+                 bool earlyExit) :
+        prefix(rows + 1, 0.0) {
+    auto start = std::chrono::steady_clock::now();
+    auto kernel = ISA_DISPATCH(selectedIsa(), calculateBatchPoints<double>);
+
+    const int probe_width = (width + COST_PROBE_STEP - 1) / COST_PROBE_STEP;
+    const int probe_rows = (rows + COST_PROBE_STEP - 1) / COST_PROBE_STEP;
+    std::vector<double> c_x(probe_width), c_y(probe_width), z_x(BATCH_SIZE), z_y(BATCH_SIZE);
+    std::vector<int> result(probe_width);
+    for (int x_probe = 0; x_probe < probe_width; x_probe++) {
+        c_x[x_probe] = x_start + std::min(x_probe * COST_PROBE_STEP + COST_PROBE_STEP / 2, width - 1) * dx;
+    }
+
+    for (int y_probe = 0; y_probe < probe_rows; y_probe++) {
+        const int row_begin = y_probe * COST_PROBE_STEP;
+        const int row_end = std::min(row_begin + COST_PROBE_STEP, rows);
+        std::fill(c_y.begin(), c_y.end(), y_start + std::min(row_begin + COST_PROBE_STEP / 2, rows - 1) * dy);
+        kernel(result.data(), c_x.data(), c_y.data(), probe_width, z_x.data(), z_y.data(), limit);
+
+        // every probed cell stands for the cells of its block, the last block may be narrower
+        double row_cost = 0.0;
+        for (int group_start = 0; group_start < width; group_start += group) {
+            const int group_end = std::min(group_start + group, width);
+            int group_max = 0;
+            double group_sum = 0.0;
+            for (int x_probe = group_start / COST_PROBE_STEP; x_probe * COST_PROBE_STEP < group_end; x_probe++) {
+                const int columns = std::min(x_probe * COST_PROBE_STEP + COST_PROBE_STEP, group_end)
+                                    - std::max(x_probe * COST_PROBE_STEP, group_start);
+                group_max = std::max(group_max, result[x_probe]);
+                group_sum += (result[x_probe] + 1.0) * columns;
+            }
+            if (not earlyExit) {
+                group_max = limit;
+            }
+            row_cost += group > 1 ? (group_max + 1.0) * (group_end - group_start) : group_sum;
+        }
+        for (int y_index = row_begin; y_index < row_end; y_index++) {
+            prefix[y_index + 1] = prefix[y_index] + row_cost;
+        }
+    }
+    probe_time = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+double CostMap::cost(int row_begin, int row_end) const {
+    return prefix[row_end] - prefix[row_begin];
+}
+
+std::vector<int> CostMap::partition(int parts) const {
+    const int rows = prefix.size() - 1;
+    std::vector<int> bands(parts + 1, rows);
+    bands[0] = 0;
+    for (int part = 1; part < parts; part++) {
+        // first line whose prefix reaches the part's share, never going back before the previous boundary
+        const double target = prefix.back() * part / parts;
+        const int boundary = std::lower_bound(prefix.begin(), prefix.end(), target) - prefix.begin();
+        bands[part] = std::max(bands[part - 1], std::min(boundary, rows));
+    }
+    return bands;
+}
+
+double CostMap::probeTime() const {
+    return probe_time;
+}
+
+double CostMap::imbalance(const std::vector<double> &costs) {
+    if (costs.empty()) {
+        return 0.0;
+    }
+    double total = 0.0, largest = 0.0;
+    for (auto cost : costs) {
+        total += cost;
+        largest = std::max(largest, cost);
+    }
+    return total > 0.0 ? largest * costs.size() / total - 1.0 : 0.0;
+}
+
+PartitionStats CostMap::predict(const std::vector<int> &bands) const {
+    const int parts = bands.size() - 1;
+    const int rows = prefix.size() - 1;
+    std::vector<double> band_costs(parts), line_costs(parts);
+    for (int part = 0; part < parts; part++) {
+        band_costs[part] = cost(bands[part], bands[part + 1]);
+        line_costs[part] = cost((long) rows * part / parts, (long) rows * (part + 1) / parts);
+    }
+    return {parts, probe_time, imbalance(band_costs), imbalance(line_costs), 0.0};
+}
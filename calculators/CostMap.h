@@ -0,0 +1,76 @@
+/**
+ * @file CostMap.h
+ * @author Matěj Konopík <xkonop03@stud.fit.vutbr.cz>
+ * @brief Predicted calculation cost of the lines from a low resolution probe, split into equal-cost bands
+ * @date 16.10.2026
+ */
+#ifndef COSTMAP_H
+#define COSTMAP_H
+
+#include <vector>
+
+#define COST_PROBE_STEP 16                      // probe one cell out of COST_PROBE_STEP x COST_PROBE_STEP
+
+/**
+ * @brief Balance of the last cost partition, imbalances as returned by CostMap::imbalance
+ */
+struct PartitionStats
+{
+    int bands;
+    double probeTime;       // [ms]
+    double predicted;       // predicted imbalance of the equal-cost bands
+    double equalLines;      // predicted imbalance of bands with the same number of lines
+    double measured;        // imbalance of the measured calculation times of the bands
+};
+
+/**
+ * @brief Prefix sums of the predicted iteration counts of the lines
+ *
+ * The probe iterates the centre cell of every COST_PROBE_STEP x COST_PROBE_STEP block and charges its
+ * iteration count (plus one for the escape check) to all the cells of the block. Kernels that iterate
+ * a group of cells until its last cell escapes are charged the group maximum for every cell of the group,
+ * kernels without the early exit the whole limit for every group that has a cell to iterate.
+ */
+class CostMap
+{
+public:
+    /**
+     * @param rows number of lines to predict, starting at y_start
+     * @param group cells of a line the kernel iterates together (1 when every cell stops on its own)
+     * @param earlyExit the kernel stops iterating the group once all its cells escaped
+     */
+    CostMap(int width, int rows, double x_start, double dx, double y_start, double dy, int limit, int group = 1,
+            bool earlyExit = true);
+
+    /**
+     * @brief Predicted cost of the lines [row_begin, row_end)
+     */
+    double cost(int row_begin, int row_end) const;
+
+    /**
+     * @brief Splits the lines into parts bands of the same predicted cost
+     * @return parts + 1 band boundaries, band i covers the lines [bands[i], bands[i + 1])
+     */
+    std::vector<int> partition(int parts) const;
+
+    /**
+     * @brief Time the probe took [ms]
+     */
+    double probeTime() const;
+
+    /**
+     * @brief Relative excess of the most expensive part over the mean one (0 for perfect balance)
+     */
+    static double imbalance(const std::vector<double> &costs);
+
+    /**
+     * @brief Fills everything but the measured imbalance of the given bands
+     */
+    PartitionStats predict(const std::vector<int> &bands) const;
+
+private:
+    std::vector<double> prefix;     // prefix[y] = predicted cost of the lines [0, y)
+    double probe_time;
+};
+
+#endif
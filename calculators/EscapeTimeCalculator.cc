@@ -0,0 +1,195 @@
+/**
+ * @file EscapeTimeCalculator.cc
+ * @author Matěj Konopík <xkonop03@stud.fit.vutbr.cz>
+ * @brief Generic escape-time calculator of the Multibrot, Julia and Burning Ship fractals, SIMD over lines
+ * @date 16.10.2026
+ */
+
+#include <iostream>
+#include <cstdlib>
+#include <type_traits>
+
+#include <omp.h>
+
+#include "EscapeTimeCalculator.h"
+
+using std::cout;
+using std::cerr;
+using std::endl;
+
+#define ALIGN_SIZE 64                           // align memory to 64 bytes (for the AVX512 registers: 64B = 512b)
+#define ESCAPE_MEM_ALLOC_ERR 9000               // error code for memory allocation failure
+
+
+//#define DEBUG   // uncomment this line to enable debug printing
+#ifdef DEBUG
+#define D_PRINT(x) std::cout << "ESCAPE_DEBUG: " << x << std::endl
+#else
+#define D_PRINT(x)
+#endif
+
+
+/**
+ * @brief Symmetry of the fractal: conj(z)^D + c = conj(z^D + c) for a real c, (-z)^D = z^D for an even D
+ */
+template <int D>
+static Symmetry fractalSymmetry(const Multibrot<D> &, double, double) {
+    return Symmetry::REAL_AXIS;
+}
+
+template <int D>
+static Symmetry fractalSymmetry(const Julia<D> &, double, double julia_im) {
+    if (julia_im == 0.0) {
+        return Symmetry::REAL_AXIS;
+    }
+    return D % 2 == 0 ? Symmetry::ORIGIN : Symmetry::NONE;
+}
+
+static Symmetry fractalSymmetry(const BurningShip &, double, double) {
+    return Symmetry::NONE;
+}
+
+static const char *symmetryName(Symmetry symmetry) {
+    switch (symmetry) {
+        case Symmetry::REAL_AXIS:
+            return "mirrored across the real axis";
+        case Symmetry::ORIGIN:
+            return "rotated about the origin";
+        default:
+            return "none";
+    }
+}
+
+
+template <typename Fractal, typename T, typename E>
+EscapeTimeCalculator<Fractal, T, E>::EscapeTimeCalculator(unsigned matrixBaseSize, unsigned limit, double juliaRe,
+                                                          double juliaIm) :
+        BaseMandelCalculator(matrixBaseSize, limit,
+                             "EscapeTimeCalculator<" + Fractal::name() + ", " + precisionName<T>()
+                             + (std::is_same<E, int>::value ? "" : std::string(", ") + storageName<E>()) + ">"),
+        julia_re(juliaRe), julia_im(juliaIm) {
+    // pick the kernel compiled for the ISA selected at startup
+    kernel = ISA_DISPATCH(selectedIsa(), calculateEscapeLine<Fractal, T>);
+    isaVariant = isaName(selectedIsa());
+    // allocate main data matrix
+    data = (E *) (aligned_alloc(ALIGN_SIZE, height * width * sizeof(E)));
+    // allocate helper arrays, every thread has its own part
+    scratch_stride = (width + 15) / 16 * 16;    // whole cache lines, so that the threads do not share them
+    z_x_temp = (T *) (aligned_alloc(ALIGN_SIZE, threads * scratch_stride * sizeof(T)));
+    z_y_temp = (T *) (aligned_alloc(ALIGN_SIZE, threads * scratch_stride * sizeof(T)));
+    line_temp = (int *) (aligned_alloc(ALIGN_SIZE, threads * scratch_stride * sizeof(int)));
+    // check allocation success
+    if (data == nullptr or z_x_temp == nullptr or z_y_temp == nullptr or line_temp == nullptr) {
+        cerr << typeid(*this).name() << " : Memory allocation failed. Aborting." << endl;
+        exit(ESCAPE_MEM_ALLOC_ERR);
+    }
+    // the lines that mirror others (or are rotated from others) are copied
+    symmetry = fractalSymmetry(Fractal(), julia_re, julia_im);
+    selectSymmetry(symmetry);
+    half_height = calculatedHeight();
+    first_row = calculatedFirstRow();
+    D_PRINT(typeid(*this).name() << " : half_height=" << half_height
+                                 << " first_row=" << first_row
+                                 << " height=" << height
+                                 << " width=" << width
+                                 << " limit=" << limit
+                                 << endl);
+}
+
+template <typename Fractal, typename T, typename E>
+EscapeTimeCalculator<Fractal, T, E>::~EscapeTimeCalculator() {
+    // free allocated data with checking against the memory validity
+    if (data != nullptr) {
+        free(data);
+    }
+    if (z_x_temp != nullptr) {
+        free(z_x_temp);
+    }
+    if (z_y_temp != nullptr) {
+        free(z_y_temp);
+    }
+    if (line_temp != nullptr) {
+        free(line_temp);
+    }
+}
+
+
+template <typename Fractal, typename T, typename E>
+E *EscapeTimeCalculator<Fractal, T, E>::calculateMandelbrot() {
+    resetPrepared();
+
+#pragma omp parallel for schedule(runtime)
+    for (int y_index = first_row; y_index < first_row + half_height; y_index++) {
+        // helper arrays of the current thread
+        const int offset = omp_get_thread_num() * scratch_stride;
+
+        // calculate the y value for the current line (given by the y_index)
+        auto y_value = T(yValue(y_index));
+        // the matrix line itself, or the scratch line of the thread for a narrow matrix
+        int *line = countLine(data, y_index, line_temp + offset);
+
+        prepareLine(line, y_index);
+        kernel(line, z_x_temp + offset, z_y_temp + offset, y_value, x_start, dx, width, limit, T(julia_re), T(julia_im));
+        storeLine(data, y_index, line);
+
+        // copy the calculated line to the line mirroring it (a window is not mirrored)
+        mirrorLine(data, y_index);
+    }
+    return data;
+}
+
+template <typename Fractal, typename T, typename E>
+void EscapeTimeCalculator<Fractal, T, E>::report(std::ostream &cout, bool batchMode) {
+    BaseMandelCalculator::report(cout, batchMode);
+    if (batchMode) {
+        return;
+    }
+    if (Fractal::julia) {
+        cout << "Julia constant:    " << julia_re << " " << julia_im << endl;
+    }
+    cout << "Symmetry:          " << symmetryName(symmetry) << ", " << height - half_height << " of "
+         << height << " lines copied" << endl;
+}
+
+template class EscapeTimeCalculator<Multibrot<2>, float, uint8_t>;
+template class EscapeTimeCalculator<Multibrot<2>, float, uint16_t>;
+template class EscapeTimeCalculator<Multibrot<2>, float, int>;
+template class EscapeTimeCalculator<Multibrot<2>, double, uint8_t>;
+template class EscapeTimeCalculator<Multibrot<2>, double, uint16_t>;
+template class EscapeTimeCalculator<Multibrot<2>, double, int>;
+template class EscapeTimeCalculator<Multibrot<3>, float, uint8_t>;
+template class EscapeTimeCalculator<Multibrot<3>, float, uint16_t>;
+template class EscapeTimeCalculator<Multibrot<3>, float, int>;
+template class EscapeTimeCalculator<Multibrot<3>, double, uint8_t>;
+template class EscapeTimeCalculator<Multibrot<3>, double, uint16_t>;
+template class EscapeTimeCalculator<Multibrot<3>, double, int>;
+template class EscapeTimeCalculator<Multibrot<4>, float, uint8_t>;
+template class EscapeTimeCalculator<Multibrot<4>, float, uint16_t>;
+template class EscapeTimeCalculator<Multibrot<4>, float, int>;
+template class EscapeTimeCalculator<Multibrot<4>, double, uint8_t>;
+template class EscapeTimeCalculator<Multibrot<4>, double, uint16_t>;
+template class EscapeTimeCalculator<Multibrot<4>, double, int>;
+template class EscapeTimeCalculator<Julia<2>, float, uint8_t>;
+template class EscapeTimeCalculator<Julia<2>, float, uint16_t>;
+template class EscapeTimeCalculator<Julia<2>, float, int>;
+template class EscapeTimeCalculator<Julia<2>, double, uint8_t>;
+template class EscapeTimeCalculator<Julia<2>, double, uint16_t>;
+template class EscapeTimeCalculator<Julia<2>, double, int>;
+template class EscapeTimeCalculator<Julia<3>, float, uint8_t>;
+template class EscapeTimeCalculator<Julia<3>, float, uint16_t>;
+template class EscapeTimeCalculator<Julia<3>, float, int>;
+template class EscapeTimeCalculator<Julia<3>, double, uint8_t>;
+template class EscapeTimeCalculator<Julia<3>, double, uint16_t>;
+template class EscapeTimeCalculator<Julia<3>, double, int>;
+template class EscapeTimeCalculator<Julia<4>, float, uint8_t>;
+template class EscapeTimeCalculator<Julia<4>, float, uint16_t>;
+template class EscapeTimeCalculator<Julia<4>, float, int>;
+template class EscapeTimeCalculator<Julia<4>, double, uint8_t>;
+template class EscapeTimeCalculator<Julia<4>, double, uint16_t>;
+template class EscapeTimeCalculator<Julia<4>, double, int>;
+template class EscapeTimeCalculator<BurningShip, float, uint8_t>;
+template class EscapeTimeCalculator<BurningShip, float, uint16_t>;
+template class EscapeTimeCalculator<BurningShip, float, int>;
+template class EscapeTimeCalculator<BurningShip, double, uint8_t>;
+template class EscapeTimeCalculator<BurningShip, double, uint16_t>;
+template class EscapeTimeCalculator<BurningShip, double, int>;
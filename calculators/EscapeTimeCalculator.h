@@ -0,0 +1,57 @@
+/**
+ * @file EscapeTimeCalculator.h
+ * @author Matěj Konopík <xkonop03@stud.fit.vutbr.cz>
+ * @brief Generic escape-time calculator of the Multibrot, Julia and Burning Ship fractals, SIMD over lines
+ * @date 16.10.2026
+ */
+#ifndef ESCAPETIMECALCULATOR_H
+#define ESCAPETIMECALCULATOR_H
+
+#include <BaseMandelCalculator.h>
+#include "EscapeTimeKernel.h"
+
+/**
+ * The Multibrot sets and the Julia sets of a real constant are mirrored across the real axis, the Julia sets
+ * of even exponents are rotated about the origin otherwise (when the view is centered on the imaginary axis).
+ *
+ * @tparam Fractal fractal tag (Multibrot<D>, Julia<D>, BurningShip), see EscapeTimeKernel.h
+ * @tparam T floating point type to iterate in (float or double)
+ * @tparam E element type of the iteration counts (uint8_t, uint16_t or int), has to hold limit
+ */
+template <typename Fractal, typename T, typename E = int>
+class EscapeTimeCalculator : public BaseMandelCalculator
+{
+public:
+    /**
+     * @param juliaRe real part of the constant of a Julia set (ignored by the other fractals)
+     * @param juliaIm imaginary part of the constant of a Julia set
+     */
+    EscapeTimeCalculator(unsigned matrixBaseSize, unsigned limit, double juliaRe = 0.0, double juliaIm = 0.0);
+    ~EscapeTimeCalculator();
+    E *calculateMandelbrot();
+    void report(std::ostream &cout, bool batchMode);
+
+private:
+    E* data;
+    int scratch_stride;         // cells of the helper arrays per thread, thread t uses [t * scratch_stride, ...)
+    T* z_x_temp;
+    T* z_y_temp;
+    int* line_temp;             // lines the counts of a narrow matrix are calculated in, see countLine
+    int half_height;
+    int first_row;      // first calculated line, see BaseMandelCalculator::calculatedFirstRow
+    const double julia_re;
+    const double julia_im;
+    Symmetry symmetry;
+    decltype(&isa_sse42::calculateEscapeLine<Fractal, T>) kernel;  // line kernel compiled for the selected ISA
+};
+
+// the variants selectable on the command line, templated on the floating point and storage types only
+template <typename T, typename E> using Multibrot2Calculator = EscapeTimeCalculator<Multibrot<2>, T, E>;
+template <typename T, typename E> using Multibrot3Calculator = EscapeTimeCalculator<Multibrot<3>, T, E>;
+template <typename T, typename E> using Multibrot4Calculator = EscapeTimeCalculator<Multibrot<4>, T, E>;
+template <typename T, typename E> using JuliaCalculator = EscapeTimeCalculator<Julia<2>, T, E>;
+template <typename T, typename E> using Julia3Calculator = EscapeTimeCalculator<Julia<3>, T, E>;
+template <typename T, typename E> using Julia4Calculator = EscapeTimeCalculator<Julia<4>, T, E>;
+template <typename T, typename E> using BurningShipCalculator = EscapeTimeCalculator<BurningShip, T, E>;
+
+#endif
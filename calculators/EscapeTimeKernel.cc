@@ -0,0 +1,155 @@
+/**
+ * @file EscapeTimeKernel.cc
+ * @author Matěj Konopík <xkonop03@stud.fit.vutbr.cz>
+ * @brief Vectorized line kernel of the generic escape-time calculator, compiled once per supported ISA
+ * @date 16.10.2026
+ */
+
+#include "EscapeTimeKernel.h"
+
+#ifndef MANDEL_ISA_NS
+#error "Kernels are compiled through the per-ISA object libraries only"
+#endif
+
+namespace MANDEL_ISA_NS {
+
+/**
+ * @brief z^D by repeated squaring, unrolled at compile time (z^2 is the same expression as in calculateLine)
+ */
+template <int D, bool ODD = D % 2 == 1>
+struct ComplexPower;
+
+template <>
+struct ComplexPower<1, true> {
+    template <typename T>
+    static inline void apply(T x, T y, T &power_x, T &power_y) {
+        power_x = x;
+        power_y = y;
+    }
+};
+
+template <int D>
+struct ComplexPower<D, false> {
+    template <typename T>
+    static inline void apply(T x, T y, T &power_x, T &power_y) {
+        T half_x, half_y;
+        ComplexPower<D / 2>::apply(x, y, half_x, half_y);
+        power_x = half_x * half_x - half_y * half_y;
+        power_y = T(2) * half_x * half_y;
+    }
+};
+
+template <int D>
+struct ComplexPower<D, true> {
+    template <typename T>
+    static inline void apply(T x, T y, T &power_x, T &power_y) {
+        T lower_x, lower_y;
+        ComplexPower<D - 1>::apply(x, y, lower_x, lower_y);
+        power_x = lower_x * x - lower_y * y;
+        power_y = lower_x * y + lower_y * x;
+    }
+};
+
+/**
+ * @brief One iteration z -> f(z) + c of the fractal
+ */
+template <typename Fractal>
+struct EscapeStep;
+
+template <int D>
+struct EscapeStep<Multibrot<D>> {
+    template <typename T>
+    static inline void apply(T &x, T &y, T c_x, T c_y) {
+        T power_x, power_y;
+        ComplexPower<D>::apply(x, y, power_x, power_y);
+        y = power_y + c_y;
+        x = power_x + c_x;
+    }
+};
+
+template <int D>
+struct EscapeStep<Julia<D>> : EscapeStep<Multibrot<D>> {
+};
+
+template <>
+struct EscapeStep<BurningShip> {
+    template <typename T>
+    static inline void apply(T &x, T &y, T c_x, T c_y) {
+        const T abs_x = x < T(0) ? -x : x;
+        const T abs_y = y < T(0) ? -y : y;
+        y = T(2) * abs_x * abs_y + c_y;
+        x = abs_x * abs_x - abs_y * abs_y + c_x;
+    }
+};
+
+template <typename Fractal, typename T>
+void calculateEscapeLine(int *line, T *z_x, T *z_y, T y_value, double x_start, double dx, int width, int limit,
+                         T c_x, T c_y) {
+    // z starts at the point of the cell, which is also c of all the fractals but the Julia sets
+#pragma omp simd simdlen(simdLen<T>())
+    for (int x_index = 0; x_index < width; x_index++) {
+        z_x[x_index] = T(x_start + x_index * dx);
+        z_y[x_index] = y_value;
+    }
+
+    for (int calc_iter = 0; calc_iter < limit; ++calc_iter) {
+        // number of cells that are still iterating, the line is done once there are none
+        int active = 0;
+#pragma omp simd simdlen(simdLen<T>()) reduction(+:active)
+        for (int x_index = 0; x_index < width; x_index++) {
+            if (line[x_index] == CELL_PENDING) {
+                T x = z_x[x_index];
+                T y = z_y[x_index];
+                if (x * x + y * y > T(4)) {
+                    line[x_index] = calc_iter;
+                } else {
+                    // the constant folds away, Fractal::julia is known at compile time
+                    const T cell_x = Fractal::julia ? c_x : T(x_start + x_index * dx);
+                    const T cell_y = Fractal::julia ? c_y : y_value;
+                    EscapeStep<Fractal>::apply(x, y, cell_x, cell_y);
+                    z_x[x_index] = x;
+                    z_y[x_index] = y;
+                    active++;
+                }
+            }
+        }
+        if (!active) break;
+    }
+
+    // the cells that did not escape are in the set
+#pragma omp simd simdlen(simdLen<int>())
+    for (int x_index = 0; x_index < width; x_index++) {
+        line[x_index] = line[x_index] == CELL_PENDING ? limit : line[x_index];
+    }
+}
+
+template void calculateEscapeLine<Multibrot<2>, float>(int *, float *, float *, float, double, double, int, int,
+                                                       float, float);
+template void calculateEscapeLine<Multibrot<2>, double>(int *, double *, double *, double, double, double, int, int,
+                                                        double, double);
+template void calculateEscapeLine<Multibrot<3>, float>(int *, float *, float *, float, double, double, int, int,
+                                                       float, float);
+template void calculateEscapeLine<Multibrot<3>, double>(int *, double *, double *, double, double, double, int, int,
+                                                        double, double);
+template void calculateEscapeLine<Multibrot<4>, float>(int *, float *, float *, float, double, double, int, int,
+                                                       float, float);
+template void calculateEscapeLine<Multibrot<4>, double>(int *, double *, double *, double, double, double, int, int,
+                                                        double, double);
+template void calculateEscapeLine<Julia<2>, float>(int *, float *, float *, float, double, double, int, int,
+                                                   float, float);
+template void calculateEscapeLine<Julia<2>, double>(int *, double *, double *, double, double, double, int, int,
+                                                    double, double);
+template void calculateEscapeLine<Julia<3>, float>(int *, float *, float *, float, double, double, int, int,
+                                                   float, float);
+template void calculateEscapeLine<Julia<3>, double>(int *, double *, double *, double, double, double, int, int,
+                                                    double, double);
+template void calculateEscapeLine<Julia<4>, float>(int *, float *, float *, float, double, double, int, int,
+                                                   float, float);
+template void calculateEscapeLine<Julia<4>, double>(int *, double *, double *, double, double, double, int, int,
+                                                    double, double);
+template void calculateEscapeLine<BurningShip, float>(int *, float *, float *, float, double, double, int, int,
+                                                      float, float);
+template void calculateEscapeLine<BurningShip, double>(int *, double *, double *, double, double, double, int, int,
+                                                       double, double);
+
+}
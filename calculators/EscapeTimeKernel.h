@@ -0,0 +1,67 @@
+/**
+ * @file EscapeTimeKernel.h
+ * @author Matěj Konopík <xkonop03@stud.fit.vutbr.cz>
+ * @brief Vectorized line kernel of the generic escape-time calculator, compiled once per supported ISA
+ * @date 16.10.2026
+ */
+#ifndef ESCAPETIMEKERNEL_H
+#define ESCAPETIMEKERNEL_H
+
+#include <string>
+
+#include "isa_dispatch.h"
+#include "ClassifierKernel.h"
+
+/**
+ * The fractals are tags only, the iteration itself is specialized inside the kernel source of every ISA.
+ */
+
+/**
+ * @brief Multibrot set, z -> z^D + c with c being the point of the cell (D = 2 is the Mandelbrot set)
+ */
+template <int D>
+struct Multibrot
+{
+    static_assert(D >= 2, "The exponent of the Multibrot set has to be at least 2");
+    static constexpr bool julia = false;
+    static std::string name() { return "Multibrot<" + std::to_string(D) + ">"; }
+};
+
+/**
+ * @brief Filled Julia set, z -> z^D + c with a constant c and z starting at the point of the cell
+ */
+template <int D>
+struct Julia
+{
+    static_assert(D >= 2, "The exponent of the Julia set has to be at least 2");
+    static constexpr bool julia = true;
+    static std::string name() { return "Julia<" + std::to_string(D) + ">"; }
+};
+
+/**
+ * @brief Burning Ship, z -> (|Re z| + i |Im z|)^2 + c with c being the point of the cell
+ */
+struct BurningShip
+{
+    static constexpr bool julia = false;
+    static std::string name() { return "BurningShip"; }
+};
+
+ISA_DECLARE(
+    /**
+     * @brief Calculates one line of the fractal, iterating over the entire line at once like calculateLine
+     *
+     * @param line output line (width cells), only its CELL_PENDING cells are calculated
+     * @param z_x helper array for the real parts (width cells)
+     * @param z_y helper array for the imaginary parts (width cells)
+     * @param c_x real part of the constant of a Julia set (ignored by the other fractals)
+     * @param c_y imaginary part of the constant of a Julia set
+     * @tparam Fractal fractal tag (Multibrot<D>, Julia<D>, BurningShip), the iteration is expanded at compile time
+     * @tparam T floating point type to iterate in
+     */
+    template <typename Fractal, typename T>
+    void calculateEscapeLine(int *line, T *z_x, T *z_y, T y_value, double x_start, double dx, int width, int limit,
+                             T c_x, T c_y);
+)
+
+#endif
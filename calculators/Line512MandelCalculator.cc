@@ -0,0 +1,137 @@
+/**
+ * @file Line512MandelCalculator.cc
+ * @author Matěj Konopík <xkonop03@stud.fit.vutbr.cz>
+ * @brief Implementation of Mandelbrot calculator that uses hand-written AVX-512 intrinsics over lines
+ * @date 16.10.2026
+ */
+
+#include <iostream>
+#include <cstdlib>
+#include <immintrin.h>
+
+#include "Line512MandelCalculator.h"
+
+using std::cout;
+using std::cerr;
+using std::endl;
+
+#define ALIGN_SIZE 64                           // align memory to 64 bytes (for the AVX512 registers: 64B = 512b)
+#define SIMD_LEN_FLOAT (512/(sizeof(float)*8))  // number of floats in AVX512 register
+#define LINE512_MEM_ALLOC_ERR 3000              // error code for memory allocation failure
+#define LINE512_ISA_ERR 3001                    // error code for missing AVX512 support
+
+
+//#define DEBUG   // uncomment this line to enable debug printing
+#ifdef DEBUG
+#define D_PRINT(x) std::cout << "LINE512_DEBUG: " << x << std::endl
+#else
+#define D_PRINT(x)
+#endif
+
+
+Line512MandelCalculator::Line512MandelCalculator(unsigned matrixBaseSize, unsigned limit) :
+        BaseMandelCalculator(matrixBaseSize, limit, "Line512MandelCalculator") {
+    // the kernel is compiled for AVX512 regardless of the build flags, refuse to run it on older CPUs
+    if (!__builtin_cpu_supports("avx512f")) {
+        cerr << typeid(*this).name() << " : CPU does not support AVX512F. Aborting." << endl;
+        exit(LINE512_ISA_ERR);
+    }
+    isaVariant = "avx512";
+    // allocate main data matrix
+    data = (int *) (aligned_alloc(ALIGN_SIZE, height * width * sizeof(int)));
+    // allocate helper array with the real parts, these are the same for every line
+    x_values = (float *) (aligned_alloc(ALIGN_SIZE, width * sizeof(float)));
+    // check allocation success
+    if (data == nullptr or x_values == nullptr) {
+        cerr << typeid(*this).name() << " : Memory allocation failed. Aborting." << endl;
+        exit(LINE512_MEM_ALLOC_ERR);
+    }
+    for (auto x_index = 0; x_index < width; x_index++) {
+        x_values[x_index] = float(x_start + x_index * dx);
+    }
+    // we use the fact that mandelbrot is symmetrical, therefore we only calculate half and then copy it
+    half_height = calculatedHeight();
+    first_row = calculatedFirstRow();
+    D_PRINT(typeid(*this).name() << " : half_height=" << half_height
+                                 << " height=" << height
+                                 << " width=" << width
+                                 << " limit=" << limit
+                                 << endl);
+}
+
+Line512MandelCalculator::~Line512MandelCalculator() {
+    // free allocated data with checking against the memory validity
+    if (data != nullptr) {
+        free(data);
+    }
+    if (x_values != nullptr) {
+        free(x_values);
+    }
+}
+
+
+/**
+ * @brief Calculates one line of the set, 16 cells at a time.
+ *
+ * z, c and the per-lane iteration counters never leave the zmm registers, the lanes that already escaped
+ * (or lie past the end of the line, or are not CELL_PENDING) are tracked in a __mmask16 and the chunk is
+ * written to data only once.
+ */
+__attribute__((target("avx512f")))
+static void calculateLine(int *line, const float *x_values, float y_value, int width, int limit) {
+    const __m512 four = _mm512_set1_ps(4.0f);
+    const __m512 two = _mm512_set1_ps(2.0f);
+    const __m512i one = _mm512_set1_epi32(1);
+    const __m512 c_y = _mm512_set1_ps(y_value);
+
+    for (auto x_index = 0; x_index < width; x_index += SIMD_LEN_FLOAT) {
+        // mask off the lanes past the end of the line in the last chunk
+        const int remaining = width - x_index;
+        const __mmask16 chunk_mask = remaining >= (int) SIMD_LEN_FLOAT ? (__mmask16) 0xFFFF
+                                                                       : (__mmask16) ((1u << remaining) - 1);
+
+        // only the CELL_PENDING cells are calculated and stored
+        const __mmask16 pending = _mm512_mask_cmpeq_epi32_mask(
+                chunk_mask, _mm512_maskz_loadu_epi32(chunk_mask, line + x_index), _mm512_set1_epi32(CELL_PENDING));
+        if (!pending) {
+            continue;
+        }
+
+        const __m512 c_x = _mm512_maskz_loadu_ps(pending, x_values + x_index);
+        __m512 z_x = c_x;
+        __m512 z_y = c_y;
+        __m512i counter = _mm512_setzero_si512();
+        __mmask16 active = pending;
+
+        for (auto iteration = 0; iteration < limit && active; iteration++) {
+            const __m512 x_squared = _mm512_mul_ps(z_x, z_x);
+            const __m512 y_squared = _mm512_mul_ps(z_y, z_y);
+
+            // lanes that stay bounded in this iteration survive it, the others keep their count
+            active = _mm512_mask_cmp_ps_mask(active, _mm512_add_ps(x_squared, y_squared), four, _CMP_LE_OQ);
+            counter = _mm512_mask_add_epi32(counter, active, counter, one);
+
+            z_y = _mm512_fmadd_ps(_mm512_mul_ps(two, z_x), z_y, c_y);
+            z_x = _mm512_add_ps(_mm512_sub_ps(x_squared, y_squared), c_x);
+        }
+        _mm512_mask_storeu_epi32(line + x_index, pending, counter);
+    }
+}
+
+
+int *Line512MandelCalculator::calculateMandelbrot() {
+    resetPrepared();
+
+    // iterate over the lines not mirrored from other ones
+    for (auto y_index = first_row; y_index < first_row + half_height; y_index++) {
+        // calculate the y value for the current line (given by the y_index)
+        auto y_value = float(yValue(y_index));
+
+        prepareLine(data + y_index * width, y_index);
+        calculateLine(data + y_index * width, x_values, y_value, width, limit);
+
+        // copy the calculated line to the line mirroring it across the real axis (a window is not mirrored)
+        mirrorLine(data, y_index);
+    }
+    return data;
+}
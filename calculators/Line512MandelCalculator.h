@@ -0,0 +1,26 @@
+/**
+ * @file Line512MandelCalculator.h
+ * @author Matěj Konopík <xkonop03@stud.fit.vutbr.cz>
+ * @brief Implementation of Mandelbrot calculator that uses hand-written AVX-512 intrinsics over lines
+ * @date 16.10.2026
+ */
+#ifndef LINE512MANDELCALCULATOR_H
+#define LINE512MANDELCALCULATOR_H
+
+#include <BaseMandelCalculator.h>
+
+class Line512MandelCalculator : public BaseMandelCalculator
+{
+public:
+    Line512MandelCalculator(unsigned matrixBaseSize, unsigned limit);
+    ~Line512MandelCalculator();
+    int *calculateMandelbrot();
+
+private:
+    int* data;
+    float* x_values;    // real part of c for every column, shared by all lines
+    int half_height;
+    int first_row;      // first calculated line, see BaseMandelCalculator::calculatedFirstRow
+};
+
+#endif
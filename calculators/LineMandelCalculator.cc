@@ -7,6 +7,11 @@
 
 #include <iostream>
 #include <cstdlib>
+#include <numeric>
+#include <type_traits>
+
+#include <omp.h>
+
 #include "LineMandelCalculator.h"
 
 using std::cout;
@@ -14,9 +19,9 @@ using std::cerr;
 using std::endl;
 
 #define ALIGN_SIZE 64                           // align memory to 64 bytes (for the AVX512 registers: 64B = 512b)
-#define SIMD_LEN_INT (512/(sizeof(int)*8))      // number of integers in AVX512 register
-#define SIMD_LEN_FLOAT (512/(sizeof(float)*8))  // number of floats in AVX512 register
 #define LINE_MEM_ALLOC_ERR 1000                 // error code for memory allocation failure
+#define LINE_STREAMS_ERR 1001                   // error code for a number of streams without a compiled kernel
+#define LINE_SMOOTH_ERR 1002                    // error code for the smooth counts combined with another kernel
 
 
 //#define DEBUG   // uncomment this line to enable debug printing
@@ -27,20 +32,71 @@ using std::endl;
 #endif
 
 
-LineMandelCalculator::LineMandelCalculator(unsigned matrixBaseSize, unsigned limit) :
-        BaseMandelCalculator(matrixBaseSize, limit, "LineMandelCalculator") {
+template <typename T, typename E>
+LineMandelCalculator<T, E>::LineMandelCalculator(unsigned matrixBaseSize, unsigned limit, bool periodicity, bool compaction, int streams, bool costPartition, bool smooth) :
+        BaseMandelCalculator(matrixBaseSize, limit, std::string("LineMandelCalculator<") + precisionName<T>()
+                                                    + (std::is_same<E, int>::value ? "" : std::string(", ") + storageName<E>()) + ">"
+                                                    + (streams > 1 ? "(S=" + std::to_string(streams) + ")" : "")
+                                                    + (smooth ? "(smooth)" : "")),
+        cost_partition(costPartition), partition_stats({0, 0.0, 0.0, 0.0, 0.0}),
+        periodicity(periodicity), periodicity_stats({0, 0}), compaction(compaction), compaction_stats({0, 0, 0}) {
+    // pick the kernels compiled for the ISA selected at startup
+    switch (streams) {
+        case 1:
+            kernel = ISA_DISPATCH(selectedIsa(), calculateLine<T, 1>);
+            break;
+        case 2:
+            kernel = ISA_DISPATCH(selectedIsa(), calculateLine<T, 2>);
+            break;
+        case 3:
+            kernel = ISA_DISPATCH(selectedIsa(), calculateLine<T, 3>);
+            break;
+        case 4:
+            kernel = ISA_DISPATCH(selectedIsa(), calculateLine<T, 4>);
+            break;
+        default:
+            cerr << typeid(*this).name() << " : Unsupported number of streams " << streams << ". Aborting." << endl;
+            exit(LINE_STREAMS_ERR);
+    }
+    periodic_kernel = ISA_DISPATCH(selectedIsa(), calculateLinePeriodic<T>);
+    compact_kernel = ISA_DISPATCH(selectedIsa(), calculateLineCompact<T>);
+    smooth_kernel = ISA_DISPATCH(selectedIsa(), calculateLineSmooth<T>);
+    if (smooth and (periodicity or compaction or streams > 1)) {
+        cerr << typeid(*this).name() << " : Smooth counts are calculated by the plain kernel only. Aborting." << endl;
+        exit(LINE_SMOOTH_ERR);
+    }
+    isaVariant = isaName(selectedIsa());
     // allocate main data matrix
-    data = (int *) (aligned_alloc(ALIGN_SIZE, height * width * sizeof(int)));
-    // allocate helper arrays
-    z_x_temp = (float *) (aligned_alloc(ALIGN_SIZE, width * sizeof(float)));
-    z_y_temp = (float *) (aligned_alloc(ALIGN_SIZE, width * sizeof(float)));
+    data = (E *) (aligned_alloc(ALIGN_SIZE, height * width * sizeof(E)));
+    smooth_data = smooth ? (float *) (aligned_alloc(ALIGN_SIZE, height * width * sizeof(float))) : nullptr;
+    // allocate helper arrays, every thread has its own part
+    scratch_stride = (width + 15) / 16 * 16;    // whole cache lines, so that the threads do not share them
+    x_values = (T *) (aligned_alloc(ALIGN_SIZE, scratch_stride * sizeof(T)));
+    z_x_temp = (T *) (aligned_alloc(ALIGN_SIZE, threads * scratch_stride * sizeof(T)));
+    z_y_temp = (T *) (aligned_alloc(ALIGN_SIZE, threads * scratch_stride * sizeof(T)));
+    line_temp = (int *) (aligned_alloc(ALIGN_SIZE, threads * scratch_stride * sizeof(int)));
+    saved_x_temp = periodicity ? (T *) (aligned_alloc(ALIGN_SIZE, threads * scratch_stride * sizeof(T))) : nullptr;
+    saved_y_temp = periodicity ? (T *) (aligned_alloc(ALIGN_SIZE, threads * scratch_stride * sizeof(T))) : nullptr;
+    c_x_temp = compaction ? (T *) (aligned_alloc(ALIGN_SIZE, threads * scratch_stride * sizeof(T))) : nullptr;
+    cell_index_temp = compaction ? (int *) (aligned_alloc(ALIGN_SIZE, threads * scratch_stride * sizeof(int))) : nullptr;
+    cell_value_temp = compaction ? (int *) (aligned_alloc(ALIGN_SIZE, threads * scratch_stride * sizeof(int))) : nullptr;
     // check allocation success
-    if (data == nullptr or z_x_temp == nullptr or z_y_temp == nullptr) {
+    if (data == nullptr or x_values == nullptr or z_x_temp == nullptr or z_y_temp == nullptr or line_temp == nullptr or
+        (smooth and smooth_data == nullptr) or
+        (periodicity and (saved_x_temp == nullptr or saved_y_temp == nullptr)) or
+        (compaction and (c_x_temp == nullptr or cell_index_temp == nullptr or cell_value_temp == nullptr))) {
         cerr << typeid(*this).name() << " : Memory allocation failed. Aborting." << endl;
         exit(LINE_MEM_ALLOC_ERR);
     }
+    // the real parts of c are the same for every line
+    for (auto x_index = 0; x_index < width; x_index++) {
+        x_values[x_index] = T(x_start + x_index * dx);
+    }
     // we use the fact that mandelbrot is symmetrical, therefore we only calculate half and then copy it
-    half_height = height / 2;
+    half_height = calculatedHeight();
+    first_row = calculatedFirstRow();
+    // pin the threads and place the matrix pages on their nodes (with a selected placement only)
+    placeMatrix(data);
     D_PRINT(typeid(*this).name() << " : half_height=" << half_height
                                  << " height=" << height
                                  << " width=" << width
@@ -48,68 +104,164 @@ LineMandelCalculator::LineMandelCalculator(unsigned matrixBaseSize, unsigned lim
                                  << endl);
 }
 
-LineMandelCalculator::~LineMandelCalculator() {
+template <typename T, typename E>
+LineMandelCalculator<T, E>::~LineMandelCalculator() {
     // free allocated data with checking against the memory validity
     if (data != nullptr) {
         free(data);
     }
+    if (smooth_data != nullptr) {
+        free(smooth_data);
+    }
+    if (x_values != nullptr) {
+        free(x_values);
+    }
     if (z_x_temp != nullptr) {
         free(z_x_temp);
     }
     if (z_y_temp != nullptr) {
         free(z_y_temp);
     }
+    if (line_temp != nullptr) {
+        free(line_temp);
+    }
+    if (saved_x_temp != nullptr) {
+        free(saved_x_temp);
+    }
+    if (saved_y_temp != nullptr) {
+        free(saved_y_temp);
+    }
+    if (c_x_temp != nullptr) {
+        free(c_x_temp);
+    }
+    if (cell_index_temp != nullptr) {
+        free(cell_index_temp);
+    }
+    if (cell_value_temp != nullptr) {
+        free(cell_value_temp);
+    }
 }
 
 
-int *LineMandelCalculator::calculateMandelbrot() {
+template <typename T, typename E>
+E *LineMandelCalculator<T, E>::calculateMandelbrot() {
+    resetPrepared();
+
+    long retired = 0, saved_iterations = 0;
+    long active_lanes = 0, line_lanes = 0, compact_lanes = 0;
+
+    // with the cost partition every thread calculates one band of lines of equal predicted cost,
+    // otherwise every line is a band of its own and the expensive ones are spread over the threads dynamically
+    std::vector<int> bands(half_height + 1);
+    std::vector<double> band_time;
+    if (cost_partition) {
+        // the line kernels iterate the entire line until its last cell escapes, the compacted one cell by cell
+        CostMap cost_map(width, half_height, x_start, dx, yValue(first_row), dy, limit, compaction ? 1 : width);
+        bands = cost_map.partition(threads);
+        for (auto &boundary : bands) {
+            boundary += first_row;
+        }
+        band_time.assign(threads, 0.0);
+        partition_stats = cost_map.predict(bands);
+    } else {
+        std::iota(bands.begin(), bands.end(), first_row);
+    }
+    const int band_count = bands.size() - 1;
 
-#pragma omp simd simdlen(SIMD_LEN_INT)
-    // prefill default values to the data array, vectorize it
-    for (auto i = 0; i < height * width; i++) {
-        data[i] = limit;
+    // the bands of the cost partition are assigned statically, band b (and its time) belongs to thread b
+    omp_sched_t schedule_kind;
+    int schedule_chunk;
+    omp_get_schedule(&schedule_kind, &schedule_chunk);
+    if (cost_partition) {
+        omp_set_schedule(omp_sched_static, 1);
     }
 
-    // iterate over first half of the lines
-    for (auto y_index = 0; y_index <= half_height; y_index++) {
-        // calculate the y value for the current line (given by the y_index)
-        auto y_value = float(y_start + y_index * dy);
+#pragma omp parallel for schedule(runtime) reduction(+:retired, saved_iterations, active_lanes, line_lanes, compact_lanes)
+    for (int band = 0; band < band_count; band++) {
+        const double band_start = omp_get_wtime();
+        for (int y_index = bands[band]; y_index < bands[band + 1]; y_index++) {
+            // helper arrays of the current thread
+            const int offset = omp_get_thread_num() * scratch_stride;
 
-        // prepare the current values for given line (y_index)
-#pragma omp simd simdlen(SIMD_LEN_FLOAT)
-        for (auto x_index = 0; x_index <= width; x_index++) {
-            z_x_temp[x_index] = float(x_start + x_index * dx);
-            z_y_temp[x_index] = y_value;
-        }
+            // calculate the y value for the current line (given by the y_index)
+            auto y_value = T(yValue(y_index));
+            // the matrix line itself, or the scratch line of the thread for a narrow matrix
+            int *line = countLine(data, y_index, line_temp + offset);
 
-        // calculate mandelbrot for given line (y_index) - iterating over the entire line
-        for (auto calc_iter = 0; calc_iter < limit; ++calc_iter) {
-            // for each cell in the line (going over the width), calculate mandelbrot
-
-            int checker = 0;
-#pragma omp simd simdlen(SIMD_LEN_FLOAT)
-            for (int x_index = 0; x_index < width; x_index++) {
-                if (data[y_index * width + x_index] == limit) {
-                    float x_squared = z_x_temp[x_index] * z_x_temp[x_index];
-                    float y_squared = z_y_temp[x_index] * z_y_temp[x_index];
-
-                    if (x_squared + y_squared > 4.0f) {
-                        data[y_index * width + x_index] = calc_iter;
-                        checker = checker - 1;
-                    } else {
-                        z_y_temp[x_index] = 2.0f * z_x_temp[x_index] * z_y_temp[x_index] + y_value;
-                        z_x_temp[x_index] = x_squared - y_squared + (x_start + x_index * dx);
-                    }
-                }
+            // calculate mandelbrot for given line (y_index) - iterating over the entire line
+            prepareLine(line, y_index);
+            if (periodicity) {
+                PeriodicityStats stats = periodic_kernel(line, z_x_temp + offset, z_y_temp + offset,
+                                                         saved_x_temp + offset, saved_y_temp + offset,
+                                                         y_value, x_start, dx, width, limit);
+                retired += stats.retired;
+                saved_iterations += stats.savedIterations;
+            } else if (compaction) {
+                CompactionStats stats = compact_kernel(line, z_x_temp + offset, z_y_temp + offset,
+                                                       c_x_temp + offset, cell_index_temp + offset, cell_value_temp + offset,
+                                                       y_value, x_start, dx, width, limit);
+                active_lanes += stats.activeLanes;
+                line_lanes += stats.lineLanes;
+                compact_lanes += stats.compactLanes;
+            } else if (smooth_data != nullptr) {
+                smooth_kernel(line, smooth_data + y_index * width, z_x_temp + offset,
+                              z_y_temp + offset, y_value, x_start, dx, width, limit);
+                mirrorLine(smooth_data, y_index);
+            } else {
+                kernel(line, z_x_temp + offset, z_y_temp + offset, x_values, y_value, width, limit);
             }
-            if (!checker) break;
-        }
 
-#pragma omp simd
-        // copy the calculated line to the second half of the matrix
-        for (auto x_index = 0; x_index < width; x_index++) {
-            data[(height - y_index - 1) * width + x_index] = data[y_index * width + x_index];
+            storeLine(data, y_index, line);
+            // copy the calculated line to the line mirroring it across the real axis (a window is not mirrored)
+            mirrorLine(data, y_index);
         }
+        if (cost_partition) {
+            band_time[band] = omp_get_wtime() - band_start;
+        }
+    }
+    omp_set_schedule(schedule_kind, schedule_chunk);
+    periodicity_stats = {retired, saved_iterations};
+    compaction_stats = {active_lanes, line_lanes, compact_lanes};
+    if (cost_partition) {
+        partition_stats.measured = CostMap::imbalance(band_time);
     }
     return data;
 }
+
+template <typename T, typename E>
+float *LineMandelCalculator<T, E>::smoothData() {
+    return smooth_data;
+}
+
+template <typename T, typename E>
+void LineMandelCalculator<T, E>::report(std::ostream &cout, bool batchMode) {
+    BaseMandelCalculator::report(cout, batchMode);
+    if (batchMode) {
+        return;
+    }
+    reportPlacement(cout, data);
+    if (cost_partition) {
+        cout << "Cost partition:    " << partition_stats.bands << " bands, probe " << partition_stats.probeTime << " ms" << endl;
+        cout << "Band imbalance:    " << 100.0 * partition_stats.predicted << " % predicted ("
+             << 100.0 * partition_stats.equalLines << " % for equal line counts), "
+             << 100.0 * partition_stats.measured << " % measured" << endl;
+    }
+    if (periodicity) {
+        cout << "Periodic cells:    " << periodicity_stats.retired << " retired early, "
+             << periodicity_stats.savedIterations << " iterations saved" << endl;
+    }
+    if (compaction) {
+        cout << "Lane utilization:  "
+             << (compaction_stats.lineLanes ? 100.0 * compaction_stats.activeLanes / compaction_stats.lineLanes : 0.0)
+             << " % before compaction, "
+             << (compaction_stats.compactLanes ? 100.0 * compaction_stats.activeLanes / compaction_stats.compactLanes : 0.0)
+             << " % after compaction" << endl;
+    }
+}
+
+template class LineMandelCalculator<float, uint8_t>;
+template class LineMandelCalculator<float, uint16_t>;
+template class LineMandelCalculator<float, int>;
+template class LineMandelCalculator<double, uint8_t>;
+template class LineMandelCalculator<double, uint16_t>;
+template class LineMandelCalculator<double, int>;
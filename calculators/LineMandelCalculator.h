@@ -6,17 +6,54 @@
  */
 
 #include <BaseMandelCalculator.h>
+#include "LineMandelKernel.h"
+#include "CostMap.h"
 
+/**
+ * @tparam T floating point type to iterate in (float or double)
+ * @tparam E element type of the iteration counts (uint8_t, uint16_t or int), has to hold limit
+ */
+template <typename T, typename E = int>
 class LineMandelCalculator : public BaseMandelCalculator
 {
 public:
-    LineMandelCalculator(unsigned matrixBaseSize, unsigned limit);
+    /**
+     * @param periodicity retire the cells whose orbit turns out to be periodic before reaching limit
+     * @param compaction iterate over the compacted still active cells only instead of the entire line
+     * @param streams number of independent streams interleaved by the kernel (1 to MAX_STREAMS)
+     * @param costPartition give every thread one band of lines of equal cost predicted by a CostMap probe
+     * @param smooth calculate the smooth iteration counts too (with the plain kernel and one stream only)
+     */
+    LineMandelCalculator(unsigned matrixBaseSize, unsigned limit, bool periodicity = false, bool compaction = false,
+                         int streams = 1, bool costPartition = false, bool smooth = false);
     ~LineMandelCalculator();
-    int *calculateMandelbrot();
+    E *calculateMandelbrot();
+    float *smoothData();
+    void report(std::ostream &cout, bool batchMode);
 
 private:
-    int* data;
-    float* z_x_temp;
-    float* z_y_temp;
+    E* data;
+    float* smooth_data;         // smooth iteration counts, nullptr unless enabled
+    int scratch_stride;         // cells of the helper arrays per thread, thread t uses [t * scratch_stride, ...)
+    T* x_values;                // real part of c for every column, shared by all lines
+    T* z_x_temp;
+    T* z_y_temp;
+    int* line_temp;             // lines the counts of a narrow matrix are calculated in, see countLine
+    T* saved_x_temp;            // saved orbit points of the periodicity check
+    T* saved_y_temp;
+    T* c_x_temp;                // compacted cells of the compaction mode
+    int* cell_index_temp;
+    int* cell_value_temp;
     int half_height;
+    int first_row;      // first calculated line, see BaseMandelCalculator::calculatedFirstRow
+    bool cost_partition;
+    PartitionStats partition_stats;
+    bool periodicity;
+    PeriodicityStats periodicity_stats;
+    bool compaction;
+    CompactionStats compaction_stats;
+    decltype(&isa_sse42::calculateLine<T>) kernel;  // line kernel compiled for the selected ISA
+    decltype(&isa_sse42::calculateLinePeriodic<T>) periodic_kernel;
+    decltype(&isa_sse42::calculateLineCompact<T>) compact_kernel;
+    decltype(&isa_sse42::calculateLineSmooth<T>) smooth_kernel;
 };
\ No newline at end of file
@@ -0,0 +1,305 @@
+/**
+ * @file LineMandelKernel.cc
+ * @author Matěj Konopík <xkonop03@stud.fit.vutbr.cz>
+ * @brief Vectorized kernel of the line calculator, compiled once per supported ISA
+ * @date 16.10.2026
+ */
+
+#include <cstdint>
+#include <cstring>
+
+#include "LineMandelKernel.h"
+
+#ifndef MANDEL_ISA_NS
+#error "Kernels are compiled through the per-ISA object libraries only"
+#endif
+
+namespace MANDEL_ISA_NS {
+
+/**
+ * @brief Runs one iteration of one cell of the line
+ *
+ * The body has no branches, so that the loops calling it vectorize: the next z is calculated for every cell
+ * and kept by the pending cells that did not escape only, the escaped ones select their iteration instead.
+ *
+ * @return 1 when the cell keeps iterating, 0 otherwise
+ */
+template <typename T>
+static inline int iterateLineCell(int *line, T *z_x, T *z_y, const T *x_values, T y_value,
+                                  int x_index, int calc_iter) {
+    const T z_x_value = z_x[x_index];
+    const T z_y_value = z_y[x_index];
+    const T x_value = x_values[x_index];
+    const T x_squared = z_x_value * z_x_value;
+    const T y_squared = z_y_value * z_y_value;
+
+    const bool pending = line[x_index] == CELL_PENDING;
+    const bool escaped = x_squared + y_squared > T(4);
+    const bool iterating = pending && !escaped;
+
+    line[x_index] = selectInt(pending && escaped, calc_iter, line[x_index]);
+    z_y[x_index] = iterating ? T(2) * z_x_value * z_y_value + y_value : z_y_value;
+    z_x[x_index] = iterating ? x_squared - y_squared + x_value : z_x_value;
+    return iterating;
+}
+
+template <typename T, int STREAMS>
+void calculateLine(int *line, T *z_x, T *z_y, const T *x_values, T y_value, int width, int limit) {
+    static_assert(STREAMS >= 1 && STREAMS <= MAX_STREAMS, "Unsupported number of interleaved streams");
+
+    // prepare the current values for given line
+#pragma omp simd simdlen(simdLen<T>())
+    for (int x_index = 0; x_index < width; x_index++) {
+        z_x[x_index] = x_values[x_index];
+        z_y[x_index] = y_value;
+    }
+
+    // the line is split into STREAMS segments of whole vectors, every loop trip advances one vector of each of them,
+    // the cells left past the last segment are iterated by a loop of their own
+    const int segment = width / (STREAMS * simdLen<T>()) * simdLen<T>();
+
+    // calculate mandelbrot for given line - iterating over the entire line
+    for (int calc_iter = 0; calc_iter < limit; ++calc_iter) {
+        // number of cells that are still iterating, the line is done once there are none
+        int active = 0;
+#pragma omp simd simdlen(simdLen<T>()) reduction(+:active)
+        for (int x_index = 0; x_index < segment; x_index++) {
+            active += iterateLineCell(line, z_x, z_y, x_values, y_value, x_index, calc_iter);
+            if (STREAMS > 1)
+                active += iterateLineCell(line, z_x, z_y, x_values, y_value, x_index + segment, calc_iter);
+            if (STREAMS > 2)
+                active += iterateLineCell(line, z_x, z_y, x_values, y_value, x_index + 2 * segment, calc_iter);
+            if (STREAMS > 3)
+                active += iterateLineCell(line, z_x, z_y, x_values, y_value, x_index + 3 * segment, calc_iter);
+        }
+#pragma omp simd simdlen(simdLen<T>()) reduction(+:active)
+        for (int x_index = STREAMS * segment; x_index < width; x_index++) {
+            active += iterateLineCell(line, z_x, z_y, x_values, y_value, x_index, calc_iter);
+        }
+        if (!active) break;
+    }
+
+    // the cells that did not escape are in the set
+#pragma omp simd simdlen(simdLen<int>())
+    for (int x_index = 0; x_index < width; x_index++) {
+        line[x_index] = line[x_index] == CELL_PENDING ? limit : line[x_index];
+    }
+}
+
+/**
+ * @brief log2 of a positive normal number, exact at the powers of two and within 1.5e-4 in between
+ *
+ * The exponent is taken from the bits, log2 of the mantissa m = 1 + t is a polynomial in t fitted on [0, 1)
+ * with p(0) = 0 and p(1) = 1, so that the approximation stays continuous.
+ */
+static inline float fastLog2(float x) {
+    int32_t bits;
+    memcpy(&bits, &x, sizeof(bits));
+    const float exponent = float((bits >> 23) - 127);
+    bits = (bits & 0x007fffff) | 0x3f800000;
+    float mantissa;
+    memcpy(&mantissa, &bits, sizeof(mantissa));
+    const float t = mantissa - 1.0f;
+    return exponent + t * (1.4380732f + t * (-0.6747667f + t * (0.3170007f - 0.0803073f * t)));
+}
+
+template <typename T>
+void calculateLineSmooth(int *line, float *smooth, T *z_x, T *z_y, T y_value,
+                         double x_start, double dx, int width, int limit) {
+    // prepare the current values for given line, smooth keeps the |z|^2 of the escape, the cells the classifier
+    // found outside escaped at z_0 = c
+#pragma omp simd simdlen(simdLen<T>())
+    for (int x_index = 0; x_index < width; x_index++) {
+        z_x[x_index] = T(x_start + x_index * dx);
+        z_y[x_index] = y_value;
+        smooth[x_index] = float(z_x[x_index] * z_x[x_index] + y_value * y_value);
+    }
+
+    for (int calc_iter = 0; calc_iter < limit; ++calc_iter) {
+        // number of cells that are still iterating, the line is done once there are none
+        int active = 0;
+#pragma omp simd simdlen(simdLen<T>()) reduction(+:active)
+        for (int x_index = 0; x_index < width; x_index++) {
+            const T z_x_value = z_x[x_index];
+            const T z_y_value = z_y[x_index];
+            const T x_squared = z_x_value * z_x_value;
+            const T y_squared = z_y_value * z_y_value;
+
+            const bool pending = line[x_index] == CELL_PENDING;
+            const bool escaped = x_squared + y_squared > T(4);
+            const bool iterating = pending && !escaped;
+
+            line[x_index] = selectInt(pending && escaped, calc_iter, line[x_index]);
+            smooth[x_index] = pending && escaped ? float(x_squared + y_squared) : smooth[x_index];
+            z_y[x_index] = iterating ? T(2) * z_x_value * z_y_value + y_value : z_y_value;
+            z_x[x_index] = iterating ? x_squared - y_squared + T(x_start + x_index * dx) : z_x_value;
+            active += iterating;
+        }
+        if (!active) break;
+    }
+
+    // the cells that did not escape are in the set, the escaped ones get n + 1 - log2(log2 |z_n|),
+    // log2 |z| = log2(|z|^2) / 2 and |z|^2 > 4 keeps the inner log2 above 1
+#pragma omp simd simdlen(simdLen<int>())
+    for (int x_index = 0; x_index < width; x_index++) {
+        const bool inside = line[x_index] == CELL_PENDING || line[x_index] == limit;
+        smooth[x_index] = inside ? float(limit) : float(line[x_index]) + 2.0f - fastLog2(fastLog2(smooth[x_index]));
+        line[x_index] = inside ? limit : line[x_index];
+    }
+}
+
+template <typename T>
+PeriodicityStats calculateLinePeriodic(int *line, T *z_x, T *z_y, T *saved_x, T *saved_y, T y_value,
+                                       double x_start, double dx, int width, int limit) {
+    const T tolerance = periodicityTolerance<T>();
+    PeriodicityStats stats = {0, 0};
+
+    // prepare the current values for given line, the starting point is the first saved one
+#pragma omp simd simdlen(simdLen<T>())
+    for (int x_index = 0; x_index < width; x_index++) {
+        z_x[x_index] = T(x_start + x_index * dx);
+        z_y[x_index] = y_value;
+        saved_x[x_index] = z_x[x_index];
+        saved_y[x_index] = y_value;
+    }
+
+    // all the cells of the line start together, so the saving schedule is the same for every lane
+    int next_save = 1;
+    for (int calc_iter = 0; calc_iter < limit; ++calc_iter) {
+        const bool save = calc_iter == next_save;
+        if (save) next_save *= 2;
+
+        int active = 0;
+        int retired = 0;
+#pragma omp simd simdlen(simdLen<T>()) reduction(+:active, retired)
+        for (int x_index = 0; x_index < width; x_index++) {
+            const T z_x_value = z_x[x_index];
+            const T z_y_value = z_y[x_index];
+            const T x_squared = z_x_value * z_x_value;
+            const T y_squared = z_y_value * z_y_value;
+            const T new_y = T(2) * z_x_value * z_y_value + y_value;
+            const T new_x = x_squared - y_squared + T(x_start + x_index * dx);
+            const T saved_x_value = saved_x[x_index];
+            const T saved_y_value = saved_y[x_index];
+            const T diff_x = new_x - saved_x_value;
+            const T diff_y = new_y - saved_y_value;
+
+            const bool pending = line[x_index] == CELL_PENDING;
+            const bool escaped = x_squared + y_squared > T(4);
+            // the orbit came back to the saved point, it will never escape
+            const bool periodic = diff_x < tolerance && diff_x > -tolerance
+                                  && diff_y < tolerance && diff_y > -tolerance;
+            const bool stepped = pending && !escaped;
+            const bool iterating = stepped && !periodic;
+
+            line[x_index] = selectInt(pending && escaped, calc_iter,
+                                      selectInt(stepped && periodic, limit, line[x_index]));
+            z_y[x_index] = stepped ? new_y : z_y_value;
+            z_x[x_index] = stepped ? new_x : z_x_value;
+            saved_y[x_index] = iterating && save ? new_y : saved_y_value;
+            saved_x[x_index] = iterating && save ? new_x : saved_x_value;
+            retired += stepped && periodic;
+            active += iterating;
+        }
+        stats.retired += retired;
+        stats.savedIterations += (long) retired * (limit - calc_iter - 1);
+        if (!active) break;
+    }
+
+    // the cells that did not escape are in the set
+#pragma omp simd simdlen(simdLen<int>())
+    for (int x_index = 0; x_index < width; x_index++) {
+        line[x_index] = line[x_index] == CELL_PENDING ? limit : line[x_index];
+    }
+    return stats;
+}
+
+template <typename T>
+CompactionStats calculateLineCompact(int *line, T *z_x, T *z_y, T *c_x, int *cell_index, int *cell_value,
+                                     T y_value, double x_start, double dx, int width, int limit) {
+    CompactionStats stats = {0, 0, 0};
+
+    // gather the pending cells of the line
+    int count = 0;
+    for (int x_index = 0; x_index < width; x_index++) {
+        if (line[x_index] == CELL_PENDING) {
+            cell_index[count++] = x_index;
+        }
+    }
+#pragma omp simd simdlen(simdLen<T>())
+    for (int i = 0; i < count; i++) {
+        c_x[i] = T(x_start + cell_index[i] * dx);
+        z_x[i] = c_x[i];
+        z_y[i] = y_value;
+        cell_value[i] = CELL_PENDING;
+    }
+
+    for (int calc_iter = 0; calc_iter < limit && count > 0; ++calc_iter) {
+        int active = 0;
+#pragma omp simd simdlen(simdLen<T>()) reduction(+:active)
+        for (int i = 0; i < count; i++) {
+            const T z_x_value = z_x[i];
+            const T z_y_value = z_y[i];
+            const T c_x_value = c_x[i];
+            const T x_squared = z_x_value * z_x_value;
+            const T y_squared = z_y_value * z_y_value;
+
+            const bool pending = cell_value[i] == CELL_PENDING;
+            const bool escaped = x_squared + y_squared > T(4);
+            const bool iterating = pending && !escaped;
+
+            cell_value[i] = selectInt(pending && escaped, calc_iter, cell_value[i]);
+            z_y[i] = iterating ? T(2) * z_x_value * z_y_value + y_value : z_y_value;
+            z_x[i] = iterating ? x_squared - y_squared + c_x_value : z_x_value;
+            active += iterating;
+        }
+        stats.activeLanes += active;
+        stats.lineLanes += width;
+        stats.compactLanes += count;
+
+        // most of the lanes are idle, scatter the escaped cells and compact the rest
+        if (active * 2 < count) {
+            int kept = 0;
+            for (int i = 0; i < count; i++) {
+                if (cell_value[i] == CELL_PENDING) {
+                    cell_index[kept] = cell_index[i];
+                    c_x[kept] = c_x[i];
+                    z_x[kept] = z_x[i];
+                    z_y[kept] = z_y[i];
+                    cell_value[kept] = CELL_PENDING;
+                    kept++;
+                } else {
+                    line[cell_index[i]] = cell_value[i];
+                }
+            }
+            count = kept;
+        }
+    }
+
+    // scatter the rest back, the cells that did not escape are in the set
+    for (int i = 0; i < count; i++) {
+        line[cell_index[i]] = cell_value[i] == CELL_PENDING ? limit : cell_value[i];
+    }
+    return stats;
+}
+
+template void calculateLine<float, 1>(int *, float *, float *, const float *, float, int, int);
+template void calculateLine<float, 2>(int *, float *, float *, const float *, float, int, int);
+template void calculateLine<float, 3>(int *, float *, float *, const float *, float, int, int);
+template void calculateLine<float, 4>(int *, float *, float *, const float *, float, int, int);
+template void calculateLine<double, 1>(int *, double *, double *, const double *, double, int, int);
+template void calculateLine<double, 2>(int *, double *, double *, const double *, double, int, int);
+template void calculateLine<double, 3>(int *, double *, double *, const double *, double, int, int);
+template void calculateLine<double, 4>(int *, double *, double *, const double *, double, int, int);
+template void calculateLineSmooth<float>(int *, float *, float *, float *, float, double, double, int, int);
+template void calculateLineSmooth<double>(int *, float *, double *, double *, double, double, double, int, int);
+template CompactionStats calculateLineCompact<float>(int *, float *, float *, float *, int *, int *, float,
+                                                     double, double, int, int);
+template CompactionStats calculateLineCompact<double>(int *, double *, double *, double *, int *, int *, double,
+                                                      double, double, int, int);
+template PeriodicityStats calculateLinePeriodic<float>(int *, float *, float *, float *, float *, float,
+                                                       double, double, int, int);
+template PeriodicityStats calculateLinePeriodic<double>(int *, double *, double *, double *, double *, double,
+                                                        double, double, int, int);
+
+}
@@ -0,0 +1,82 @@
+/**
+ * @file LineMandelKernel.h
+ * @author Matěj Konopík <xkonop03@stud.fit.vutbr.cz>
+ * @brief Vectorized kernel of the line calculator, compiled once per supported ISA
+ * @date 16.10.2026
+ */
+#ifndef LINEMANDELKERNEL_H
+#define LINEMANDELKERNEL_H
+
+#include "isa_dispatch.h"
+#include "ClassifierKernel.h"
+#include "PeriodicityCheck.h"
+
+/**
+ * @brief Lane counters of the stream compaction mode of the line kernel, summed over the iterations
+ */
+struct CompactionStats {
+    long activeLanes;                           // lanes doing useful work
+    long lineLanes;                             // lanes the full line would have occupied
+    long compactLanes;                          // lanes the compacted cells occupied
+};
+
+ISA_DECLARE(
+    /**
+     * @brief Calculates one line of the set, iterating over the entire line at once
+     *
+     * @param line output line (width cells), only its CELL_PENDING cells are calculated
+     * @param z_x helper array for the real parts (width cells)
+     * @param z_y helper array for the imaginary parts (width cells)
+     * @param x_values real parts of c of the cells (width cells), the same for every line
+     * @tparam T floating point type to iterate in
+     * @tparam STREAMS number of independent streams interleaved in one loop trip (1 to MAX_STREAMS)
+     */
+    template <typename T, int STREAMS = 1>
+    void calculateLine(int *line, T *z_x, T *z_y, const T *x_values, T y_value, int width, int limit);
+
+    /**
+     * @brief Calculates one line of the set like calculateLine, together with the smooth iteration counts
+     *
+     * An escaped cell gets n + 1 - log2(log2 |z_n|), continuous across the bands of the integer count n,
+     * evaluated by a polynomial log2 approximation once the line is done, from the |z|^2 kept at the escape check.
+     * The other cells get their integer count.
+     *
+     * @param smooth output line of the smooth counts (width cells)
+     */
+    template <typename T>
+    void calculateLineSmooth(int *line, float *smooth, T *z_x, T *z_y, T y_value,
+                             double x_start, double dx, int width, int limit);
+
+    /**
+     * @brief Calculates one line of the set like calculateLine, retiring the cells whose orbit is periodic
+     *
+     * Every cell keeps an orbit point saved at the power-of-two iterations (Brent), a cell that returns
+     * to its saved point within periodicityTolerance is in a cycle and is set to limit right away.
+     *
+     * @param saved_x helper array for the real parts of the saved orbit points (width cells)
+     * @param saved_y helper array for the imaginary parts of the saved orbit points (width cells)
+     * @return number of retired cells and iterations saved by retiring them
+     */
+    template <typename T>
+    PeriodicityStats calculateLinePeriodic(int *line, T *z_x, T *z_y, T *saved_x, T *saved_y, T y_value,
+                                           double x_start, double dx, int width, int limit);
+
+    /**
+     * @brief Calculates one line of the set like calculateLine, iterating over the still active cells only
+     *
+     * The pending cells are gathered into dense arrays, whenever less than half of them is still
+     * iterating the escaped ones are scattered back to the line and the rest is compacted.
+     *
+     * @param z_x helper array for the real parts of the compacted cells (width cells)
+     * @param z_y helper array for the imaginary parts of the compacted cells (width cells)
+     * @param c_x helper array for the real parts of the compacted cells' points (width cells)
+     * @param cell_index helper array for the columns of the compacted cells (width cells)
+     * @param cell_value helper array for the values of the compacted cells (width cells)
+     * @return lane counters before and after compaction
+     */
+    template <typename T>
+    CompactionStats calculateLineCompact(int *line, T *z_x, T *z_y, T *c_x, int *cell_index, int *cell_value,
+                                         T y_value, double x_start, double dx, int width, int limit);
+)
+
+#endif
@@ -0,0 +1,149 @@
+/**
+ * @file MixedMandelCalculator.cc
+ * @author Matěj Konopík <xkonop03@stud.fit.vutbr.cz>
+ * @brief Mandelbrot calculator iterating in float and recalculating only the precision-unsafe cells in double
+ * @date 16.10.2026
+ */
+
+#include <iostream>
+#include <cstdlib>
+#include <cmath>
+#include <cfloat>
+
+#include "MixedMandelCalculator.h"
+
+using std::cout;
+using std::cerr;
+using std::endl;
+
+#define ALIGN_SIZE 64                           // align memory to 64 bytes (for the AVX512 registers: 64B = 512b)
+#define MIXED_SAFETY 256                        // required number of float ulps of |c| per cell step
+#define MIXED_MEM_ALLOC_ERR 5000                // error code for memory allocation failure
+
+
+//#define DEBUG   // uncomment this line to enable debug printing
+#ifdef DEBUG
+#define D_PRINT(x) std::cout << "MIXED_DEBUG: " << x << std::endl
+#else
+#define D_PRINT(x)
+#endif
+
+
+MixedMandelCalculator::MixedMandelCalculator(unsigned matrixBaseSize, unsigned limit) :
+        BaseMandelCalculator(matrixBaseSize, limit, "MixedMandelCalculator"), escalated(0) {
+    // pick the kernels compiled for the ISA selected at startup
+    line_kernel = ISA_DISPATCH(selectedIsa(), calculateLine<float>);
+    cells_kernel = ISA_DISPATCH(selectedIsa(), calculateBatchCells<double>);
+    isaVariant = isaName(selectedIsa());
+    // allocate main data matrix
+    data = (int *) (aligned_alloc(ALIGN_SIZE, height * width * sizeof(int)));
+    // allocate helper arrays
+    x_values = (float *) (aligned_alloc(ALIGN_SIZE, width * sizeof(float)));
+    z_x_float = (float *) (aligned_alloc(ALIGN_SIZE, width * sizeof(float)));
+    z_y_float = (float *) (aligned_alloc(ALIGN_SIZE, width * sizeof(float)));
+    z_x_double = (double *) (aligned_alloc(ALIGN_SIZE, BATCH_SIZE * sizeof(double)));
+    z_y_double = (double *) (aligned_alloc(ALIGN_SIZE, BATCH_SIZE * sizeof(double)));
+    unsafe_cells = (int *) (aligned_alloc(ALIGN_SIZE, width * sizeof(int)));
+    unsafe_columns = (bool *) (aligned_alloc(ALIGN_SIZE, width * sizeof(bool)));
+    // check allocation success
+    if (data == nullptr or x_values == nullptr or z_x_float == nullptr or z_y_float == nullptr or
+        z_x_double == nullptr or z_y_double == nullptr or unsafe_cells == nullptr or unsafe_columns == nullptr) {
+        cerr << typeid(*this).name() << " : Memory allocation failed. Aborting." << endl;
+        exit(MIXED_MEM_ALLOC_ERR);
+    }
+    // the real parts of c of the columns, float cannot tell them apart when the step gets close to the ulp of c
+    for (auto x_index = 0; x_index < width; x_index++) {
+        x_values[x_index] = float(x_start + x_index * dx);
+        unsafe_columns[x_index] = dx < MIXED_SAFETY * FLT_EPSILON * std::fabs(x_start + x_index * dx);
+    }
+    // we use the fact that mandelbrot is symmetrical, therefore we only calculate half and then copy it
+    half_height = calculatedHeight();
+    first_row = calculatedFirstRow();
+    D_PRINT(typeid(*this).name() << " : half_height=" << half_height
+                                 << " height=" << height
+                                 << " width=" << width
+                                 << " limit=" << limit
+                                 << endl);
+}
+
+MixedMandelCalculator::~MixedMandelCalculator() {
+    // free allocated data with checking against the memory validity
+    if (data != nullptr) {
+        free(data);
+    }
+    if (x_values != nullptr) {
+        free(x_values);
+    }
+    if (z_x_float != nullptr) {
+        free(z_x_float);
+    }
+    if (z_y_float != nullptr) {
+        free(z_y_float);
+    }
+    if (z_x_double != nullptr) {
+        free(z_x_double);
+    }
+    if (z_y_double != nullptr) {
+        free(z_y_double);
+    }
+    if (unsafe_cells != nullptr) {
+        free(unsafe_cells);
+    }
+    if (unsafe_columns != nullptr) {
+        free(unsafe_columns);
+    }
+}
+
+
+int *MixedMandelCalculator::calculateMandelbrot() {
+    resetPrepared();
+
+    // iterate over the lines not mirrored from other ones in float, line by line
+    for (auto y_index = first_row; y_index < first_row + half_height; y_index++) {
+        auto y_value = float(yValue(y_index));
+        prepareLine(data + y_index * width, y_index);
+        line_kernel(data + y_index * width, z_x_float, z_y_float, x_values, y_value, width, limit);
+    }
+
+    // recalculate the precision-unsafe cells in double, line by line
+    escalated = 0;
+    for (auto y_index = first_row; y_index < first_row + half_height; y_index++) {
+        int *line = data + y_index * width;
+        const int *above = y_index > first_row ? line - width : nullptr;
+        const int *below = y_index + 1 < first_row + half_height ? line + width : nullptr;
+        auto y_value = yValue(y_index);
+        const bool unsafe_line = dy < MIXED_SAFETY * FLT_EPSILON * std::fabs(y_value);
+
+        // a cell is unsafe when float cannot resolve it or its neighbours disagree on it being in the set
+        int count = 0;
+        for (auto x_index = 0; x_index < width; x_index++) {
+            const bool inside = line[x_index] == limit;
+            const bool unsafe = unsafe_line or unsafe_columns[x_index]
+                                or (x_index > 0 and (line[x_index - 1] == limit) != inside)
+                                or (x_index + 1 < width and (line[x_index + 1] == limit) != inside)
+                                or (above != nullptr and (above[x_index] == limit) != inside)
+                                or (below != nullptr and (below[x_index] == limit) != inside);
+            if (unsafe) {
+                unsafe_cells[count++] = x_index;
+            }
+        }
+        if (count > 0) {
+            cells_kernel(line, unsafe_cells, count, z_x_double, z_y_double, y_value, x_start, dx, limit);
+            escalated += count;
+        }
+
+        // copy the calculated line to the line mirroring it across the real axis (a window is not mirrored)
+        mirrorLine(data, y_index);
+    }
+    D_PRINT("escalated: " << escalated);
+    return data;
+}
+
+void MixedMandelCalculator::report(std::ostream &cout, bool batchMode) {
+    BaseMandelCalculator::report(cout, batchMode);
+    if (batchMode) {
+        return;
+    }
+    cout << "Escalated cells:   " << escalated << " ("
+         << 100.0 * escalated / ((long) half_height * width) << " % of the calculated lines)" << endl;
+}
@@ -0,0 +1,39 @@
+/**
+ * @file MixedMandelCalculator.h
+ * @author Matěj Konopík <xkonop03@stud.fit.vutbr.cz>
+ * @brief Mandelbrot calculator iterating in float and recalculating only the precision-unsafe cells in double
+ * @date 16.10.2026
+ */
+#ifndef MIXEDMANDELCALCULATOR_H
+#define MIXEDMANDELCALCULATOR_H
+
+#include <BaseMandelCalculator.h>
+#include "LineMandelKernel.h"
+#include "BatchMandelKernel.h"
+
+class MixedMandelCalculator : public BaseMandelCalculator
+{
+public:
+    MixedMandelCalculator(unsigned matrixBaseSize, unsigned limit);
+    ~MixedMandelCalculator();
+    int *calculateMandelbrot();
+    void report(std::ostream &cout, bool batchMode);
+
+private:
+    int* data;
+    float* x_values;            // real part of c for every column, shared by all lines
+    float* z_x_float;
+    float* z_y_float;
+    double* z_x_double;
+    double* z_y_double;
+    int* unsafe_cells;          // indices of the cells of the current line to be recalculated
+    bool* unsafe_columns;       // columns too close to each other for float
+    int half_height;
+    int first_row;      // first calculated line, see BaseMandelCalculator::calculatedFirstRow
+    long escalated;
+
+    decltype(&isa_sse42::calculateLine<float>) line_kernel;          // float kernel compiled for the selected ISA
+    decltype(&isa_sse42::calculateBatchCells<double>) cells_kernel;  // double kernel compiled for the selected ISA
+};
+
+#endif
@@ -0,0 +1,30 @@
+/**
+ * @file PeriodicityCheck.h
+ * @author Matěj Konopík <xkonop03@stud.fit.vutbr.cz>
+ * @brief Shared parameters and statistics of the periodicity (cycle) detection in the iteration kernels
+ * @date 16.10.2026
+ */
+#ifndef PERIODICITYCHECK_H
+#define PERIODICITYCHECK_H
+
+#include <limits>
+
+#define PERIODICITY_TOLERANCE_ULPS 16           // orbit points closer than this many ulps of 1 are the same point
+
+/**
+ * @brief Counters of the cells retired by the periodicity check
+ */
+struct PeriodicityStats {
+    long retired;                               // cells found to be in a cycle and set to limit
+    long savedIterations;                       // iterations the retired cells would still have run
+};
+
+/**
+ * @brief Distance under which an orbit is considered to have returned to its saved point
+ */
+template <typename T>
+inline T periodicityTolerance() {
+    return T(PERIODICITY_TOLERANCE_ULPS) * std::numeric_limits<T>::epsilon();
+}
+
+#endif
@@ -0,0 +1,212 @@
+/**
+ * @file PerturbationMandelCalculator.cc
+ * @author Matěj Konopík <xkonop03@stud.fit.vutbr.cz>
+ * @brief Deep zoom Mandelbrot calculator iterating cells as SIMD deltas from one high precision reference orbit
+ * @date 16.10.2026
+ */
+
+#include <iostream>
+#include <cstdlib>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <xmmintrin.h>
+
+#include "fixed_point.h"
+#include "PerturbationMandelCalculator.h"
+
+using std::cout;
+using std::cerr;
+using std::endl;
+
+#define ALIGN_SIZE 64                           // align memory to 64 bytes (for the AVX512 registers: 64B = 512b)
+#define REF_FRAC_LIMBS 4                        // 256 fractional bits of the reference orbit (~77 digits)
+#define PERTURBATION_MEM_ALLOC_ERR 4000         // error code for memory allocation failure
+#define PERTURBATION_CENTER_ERR 4001            // error code for unparsable view center
+#define MXCSR_FTZ_DAZ 0x8040                    // flush-to-zero and denormals-are-zero bits of MXCSR
+
+
+//#define DEBUG   // uncomment this line to enable debug printing
+#ifdef DEBUG
+#define D_PRINT(x) std::cout << "PERTURBATION_DEBUG: " << x << std::endl
+#else
+#define D_PRINT(x)
+#endif
+
+typedef FixedPoint<REF_FRAC_LIMBS> RefFixed;
+
+
+template <typename T>
+PerturbationMandelCalculator<T>::PerturbationMandelCalculator(unsigned matrixBaseSize, unsigned limit, bool useSeries) :
+        BaseMandelCalculator(matrixBaseSize, limit, std::string("PerturbationMandelCalculator<") + precisionName<T>() + ">"),
+        use_series(useSeries), rebases(0) {
+    // pick the kernel compiled for the ISA selected at startup
+    kernel = ISA_DISPATCH(selectedIsa(), calculatePerturbationLine<T>);
+    isaVariant = isaName(selectedIsa());
+    // allocate main data matrix
+    data = (int *) (aligned_alloc(ALIGN_SIZE, height * width * sizeof(int)));
+    // allocate reference orbit (Z_0 .. Z_limit) and helper arrays
+    ref_x = (T *) (aligned_alloc(ALIGN_SIZE, (limit + 1) * sizeof(T)));
+    ref_y = (T *) (aligned_alloc(ALIGN_SIZE, (limit + 1) * sizeof(T)));
+    dc_x = (T *) (aligned_alloc(ALIGN_SIZE, width * sizeof(T)));
+    dz_x_temp = (T *) (aligned_alloc(ALIGN_SIZE, PERTURBATION_CHUNK * sizeof(T)));
+    dz_y_temp = (T *) (aligned_alloc(ALIGN_SIZE, PERTURBATION_CHUNK * sizeof(T)));
+    ref_index_temp = (int *) (aligned_alloc(ALIGN_SIZE, PERTURBATION_CHUNK * sizeof(int)));
+    // check allocation success
+    if (data == nullptr or ref_x == nullptr or ref_y == nullptr or dc_x == nullptr or
+        dz_x_temp == nullptr or dz_y_temp == nullptr or ref_index_temp == nullptr) {
+        cerr << typeid(*this).name() << " : Memory allocation failed. Aborting." << endl;
+        exit(PERTURBATION_MEM_ALLOC_ERR);
+    }
+    // the reference is the center of the view
+    for (auto x_index = 0; x_index < width; x_index++) {
+        dc_x[x_index] = T((x_index - (width - 1) / 2.0) * dx);
+    }
+    ref_len = 0;
+    series = PerturbationSeries<T>();
+    D_PRINT(typeid(*this).name() << " : center=" << viewport.centerRe << " " << viewport.centerIm
+                                 << " zoom=" << viewport.zoom
+                                 << " width=" << width
+                                 << " limit=" << limit
+                                 << endl);
+}
+
+template <typename T>
+PerturbationMandelCalculator<T>::~PerturbationMandelCalculator() {
+    // free allocated data with checking against the memory validity
+    if (data != nullptr) {
+        free(data);
+    }
+    if (ref_x != nullptr) {
+        free(ref_x);
+    }
+    if (ref_y != nullptr) {
+        free(ref_y);
+    }
+    if (dc_x != nullptr) {
+        free(dc_x);
+    }
+    if (dz_x_temp != nullptr) {
+        free(dz_x_temp);
+    }
+    if (dz_y_temp != nullptr) {
+        free(dz_y_temp);
+    }
+    if (ref_index_temp != nullptr) {
+        free(ref_index_temp);
+    }
+}
+
+
+/**
+ * @brief Iterates the view center in fixed point and the series coefficients along with it.
+ *
+ * The coefficients are kept scaled by the powers of the view radius (a = A*r, b = B*r^2, c = C*r^3),
+ * the series is used for as long as the cubic term stays below the precision of T and no cell of the
+ * view can have escaped yet.
+ */
+template <typename T>
+void PerturbationMandelCalculator<T>::calculateReference() {
+    RefFixed c_re, c_im;
+    try {
+        c_re = RefFixed::fromString(viewport.centerRe);
+        c_im = RefFixed::fromString(viewport.centerIm);
+    } catch (const std::invalid_argument &e) {
+        cerr << typeid(*this).name() << " : " << e.what() << ". Aborting." << endl;
+        exit(PERTURBATION_CENTER_ERR);
+    }
+
+    const double radius = std::hypot((width - 1) / 2.0 * dx, (imageHeight - 1) / 2.0 * dy);
+    const double epsilon = std::numeric_limits<T>::epsilon();
+    double a_x = 0.0, a_y = 0.0, b_x = 0.0, b_y = 0.0, c_x = 0.0, c_y = 0.0;
+    bool series_valid = use_series;
+    int skip = 0;
+
+    RefFixed z_re, z_im;
+    double z_x = 0.0, z_y = 0.0;
+    ref_x[0] = T(0);
+    ref_y[0] = T(0);
+    ref_len = 1;
+    for (auto iteration = 1; iteration <= limit; iteration++) {
+        RefFixed z_re_im = z_re * z_im;
+        RefFixed next_re = z_re * z_re - z_im * z_im + c_re;
+        z_im = z_re_im + z_re_im + c_im;
+        z_re = next_re;
+
+        if (series_valid) {
+            // A' = 2ZA + 1, B' = 2ZB + A^2, C' = 2ZC + 2AB with Z being the previous orbit point
+            double na_x = 2.0 * (z_x * a_x - z_y * a_y) + radius;
+            double na_y = 2.0 * (z_x * a_y + z_y * a_x);
+            double nb_x = 2.0 * (z_x * b_x - z_y * b_y) + a_x * a_x - a_y * a_y;
+            double nb_y = 2.0 * (z_x * b_y + z_y * b_x) + 2.0 * a_x * a_y;
+            double nc_x = 2.0 * (z_x * c_x - z_y * c_y) + 2.0 * (a_x * b_x - a_y * b_y);
+            double nc_y = 2.0 * (z_x * c_y + z_y * c_x) + 2.0 * (a_x * b_y + a_y * b_x);
+
+            double delta_max = std::hypot(na_x, na_y) + std::hypot(nb_x, nb_y) + std::hypot(nc_x, nc_y);
+            if (std::hypot(nc_x, nc_y) <= epsilon * std::hypot(na_x, na_y) and
+                std::hypot(z_re.toDouble(), z_im.toDouble()) + delta_max < 2.0) {
+                a_x = na_x; a_y = na_y;
+                b_x = nb_x; b_y = nb_y;
+                c_x = nc_x; c_y = nc_y;
+                skip = iteration;
+            } else {
+                series_valid = false;
+            }
+        }
+
+        z_x = z_re.toDouble();
+        z_y = z_im.toDouble();
+        ref_x[iteration] = T(z_x);
+        ref_y[iteration] = T(z_y);
+        ref_len = iteration + 1;
+        if (z_x * z_x + z_y * z_y > 4.0) {
+            break;
+        }
+    }
+
+    series.a_x = T(a_x); series.a_y = T(a_y);
+    series.b_x = T(b_x); series.b_y = T(b_y);
+    series.c_x = T(c_x); series.c_y = T(c_y);
+    series.radius_inv = T(1.0 / radius);
+    series.skip = skip;
+    D_PRINT("reference length: " << ref_len << " series skip: " << skip);
+}
+
+
+template <typename T>
+int *PerturbationMandelCalculator<T>::calculateMandelbrot() {
+    calculateReference();
+
+    // delta^2 underflows at deep zooms, denormal arithmetic would slow the kernel down by an order of magnitude
+    const unsigned int mxcsr = _mm_getcsr();
+    _mm_setcsr(mxcsr | MXCSR_FTZ_DAZ);
+
+    rebases = 0;
+    const int first_row = calculatedFirstRow();
+    for (auto y_index = first_row; y_index < first_row + calculatedHeight(); y_index++) {
+        // offset of the current line from the reference (the center of the whole image)
+        auto dc_y = T((rowOffset + y_index - (imageHeight - 1) / 2.0) * dy);
+
+        rebases += kernel(data + y_index * width, dz_x_temp, dz_y_temp, ref_index_temp,
+                          dc_x, dc_y, ref_x, ref_y, ref_len, series, width, limit);
+        // the view is mirrored where it overlaps with its reflection across the real axis
+        mirrorLine(data, y_index);
+    }
+
+    _mm_setcsr(mxcsr);
+    return data;
+}
+
+template <typename T>
+void PerturbationMandelCalculator<T>::report(std::ostream &cout, bool batchMode) {
+    BaseMandelCalculator::report(cout, batchMode);
+    if (batchMode) {
+        return;
+    }
+    cout << "Reference orbit:   " << ref_len - 1 << " iterations" << endl;
+    cout << "Series skipped:    " << series.skip << " iterations" << endl;
+    cout << "Rebases:           " << rebases << endl;
+}
+
+template class PerturbationMandelCalculator<float>;
+template class PerturbationMandelCalculator<double>;
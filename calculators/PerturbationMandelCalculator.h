@@ -0,0 +1,52 @@
+/**
+ * @file PerturbationMandelCalculator.h
+ * @author Matěj Konopík <xkonop03@stud.fit.vutbr.cz>
+ * @brief Deep zoom Mandelbrot calculator iterating cells as SIMD deltas from one high precision reference orbit
+ * @date 16.10.2026
+ */
+#ifndef PERTURBATIONMANDELCALCULATOR_H
+#define PERTURBATIONMANDELCALCULATOR_H
+
+#include <string>
+
+#include <BaseMandelCalculator.h>
+#include "PerturbationMandelKernel.h"
+
+/**
+ * @tparam T floating point type of the deltas (float or double)
+ */
+template <typename T>
+class PerturbationMandelCalculator : public BaseMandelCalculator
+{
+public:
+    /**
+     * The view is the selected viewport (see BaseMandelCalculator::selectViewport), the reference orbit
+     * is iterated with all the digits of its center.
+     *
+     * @param useSeries skip the first iterations using series approximation
+     */
+    PerturbationMandelCalculator(unsigned matrixBaseSize, unsigned limit, bool useSeries);
+    ~PerturbationMandelCalculator();
+    int *calculateMandelbrot();
+    void report(std::ostream &cout, bool batchMode);
+
+private:
+    int* data;
+    T* ref_x;           // reference orbit, Z_0 = 0
+    T* ref_y;
+    int ref_len;
+    T* dc_x;            // offset of every column from the reference
+    T* dz_x_temp;
+    T* dz_y_temp;
+    int* ref_index_temp;
+
+    const bool use_series;
+    PerturbationSeries<T> series;
+    long rebases;
+
+    decltype(&isa_sse42::calculatePerturbationLine<T>) kernel;  // line kernel compiled for the selected ISA
+
+    void calculateReference();
+};
+
+#endif
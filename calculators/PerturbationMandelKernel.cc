@@ -0,0 +1,96 @@
+/**
+ * @file PerturbationMandelKernel.cc
+ * @author Matěj Konopík <xkonop03@stud.fit.vutbr.cz>
+ * @brief Vectorized kernel of the perturbation calculator, compiled once per supported ISA
+ * @date 16.10.2026
+ */
+
+#include "PerturbationMandelKernel.h"
+
+#ifndef MANDEL_ISA_NS
+#error "Kernels are compiled through the per-ISA object libraries only"
+#endif
+
+namespace MANDEL_ISA_NS {
+
+template <typename T>
+long calculatePerturbationLine(int *line, T *dz_x, T *dz_y, int *ref_index,
+                               const T *dc_x, T dc_y, const T *ref_x, const T *ref_y, int ref_len,
+                               const PerturbationSeries<T> &series, int width, int limit) {
+    long rebases = 0;
+
+    for (int chunk_start = 0; chunk_start < width; chunk_start += PERTURBATION_CHUNK) {
+        const int chunk_size = width - chunk_start < PERTURBATION_CHUNK ? width - chunk_start : PERTURBATION_CHUNK;
+
+        // start every cell from the series approximation (delta_0 = 0 when nothing is skipped)
+#pragma omp simd simdlen(simdLen<T>())
+        for (int i = 0; i < chunk_size; i++) {
+            T u_x = dc_x[chunk_start + i] * series.radius_inv;
+            T u_y = dc_y * series.radius_inv;
+            // Horner scheme ((c*u + b)*u + a)*u
+            T t_x = series.c_x * u_x - series.c_y * u_y + series.b_x;
+            T t_y = series.c_x * u_y + series.c_y * u_x + series.b_y;
+            T s_x = t_x * u_x - t_y * u_y + series.a_x;
+            T s_y = t_x * u_y + t_y * u_x + series.a_y;
+            dz_x[i] = s_x * u_x - s_y * u_y;
+            dz_y[i] = s_x * u_y + s_y * u_x;
+            ref_index[i] = series.skip;
+            line[chunk_start + i] = limit;
+        }
+
+        for (int iteration = series.skip; iteration < limit; iteration++) {
+            // number of cells that are still iterating, the chunk is done once there are none
+            int active = 0;
+            int rebased = 0;
+#pragma omp simd simdlen(simdLen<T>()) reduction(+:active, rebased)
+            for (int i = 0; i < chunk_size; i++) {
+                const int x_index = chunk_start + i;
+                if (line[x_index] == limit) {
+                    int m = ref_index[i];
+                    T d_x = dz_x[i];
+                    T d_y = dz_y[i];
+
+                    // delta' = (2 * Z_m + delta) * delta + delta_c
+                    T t_x = T(2) * ref_x[m] + d_x;
+                    T t_y = T(2) * ref_y[m] + d_y;
+                    T n_x = t_x * d_x - t_y * d_y + dc_x[x_index];
+                    T n_y = t_x * d_y + t_y * d_x + dc_y;
+                    m++;
+
+                    // full value of the cell z = Z_m + delta
+                    T z_x = ref_x[m] + n_x;
+                    T z_y = ref_y[m] + n_y;
+                    T z_squared = z_x * z_x + z_y * z_y;
+
+                    if (z_squared > T(4)) {
+                        line[x_index] = iteration;
+                    } else {
+                        // glitch (orbit closer to 0 than to the reference) or end of the reference, rebase
+                        if (z_squared < n_x * n_x + n_y * n_y || m == ref_len - 1) {
+                            n_x = z_x;
+                            n_y = z_y;
+                            m = 0;
+                            rebased++;
+                        }
+                        dz_x[i] = n_x;
+                        dz_y[i] = n_y;
+                        ref_index[i] = m;
+                        active++;
+                    }
+                }
+            }
+            rebases += rebased;
+            if (!active) break;
+        }
+    }
+    return rebases;
+}
+
+template long calculatePerturbationLine<float>(int *, float *, float *, int *, const float *, float,
+                                               const float *, const float *, int,
+                                               const PerturbationSeries<float> &, int, int);
+template long calculatePerturbationLine<double>(int *, double *, double *, int *, const double *, double,
+                                                const double *, const double *, int,
+                                                const PerturbationSeries<double> &, int, int);
+
+}
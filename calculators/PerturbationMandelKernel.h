@@ -0,0 +1,49 @@
+/**
+ * @file PerturbationMandelKernel.h
+ * @author Matěj Konopík <xkonop03@stud.fit.vutbr.cz>
+ * @brief Vectorized kernel of the perturbation calculator, compiled once per supported ISA
+ * @date 16.10.2026
+ */
+#ifndef PERTURBATIONMANDELKERNEL_H
+#define PERTURBATIONMANDELKERNEL_H
+
+#include "isa_dispatch.h"
+
+#define PERTURBATION_CHUNK 64                   // number of cells iterated together
+
+/**
+ * @brief Truncated series delta_n = a*u + b*u^2 + c*u^3 of the reference orbit, u = delta_c / radius
+ *
+ * The coefficients are pre-scaled by the powers of radius so they stay representable at any zoom.
+ */
+template <typename T>
+struct PerturbationSeries
+{
+    T a_x, a_y;
+    T b_x, b_y;
+    T c_x, c_y;
+    T radius_inv;
+    int skip;       // number of iterations approximated by the series
+};
+
+ISA_DECLARE(
+    /**
+     * @brief Calculates one line of the set as deltas from the reference orbit
+     *
+     * Cells whose orbit gets closer to zero than to the reference (or run past its end) are rebased
+     * onto the beginning of the reference orbit.
+     *
+     * @param line output line (width cells)
+     * @param dz_x, dz_y, ref_index helper arrays (PERTURBATION_CHUNK cells)
+     * @param dc_x real part of delta c for every column (width cells)
+     * @param dc_y imaginary part of delta c of the line
+     * @param ref_x, ref_y reference orbit starting with Z_0 = 0 (ref_len values)
+     * @return number of rebases performed
+     */
+    template <typename T>
+    long calculatePerturbationLine(int *line, T *dz_x, T *dz_y, int *ref_index,
+                                   const T *dc_x, T dc_y, const T *ref_x, const T *ref_y, int ref_len,
+                                   const PerturbationSeries<T> &series, int width, int limit);
+)
+
+#endif
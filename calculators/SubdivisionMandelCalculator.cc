@@ -0,0 +1,207 @@
+/**
+ * @file SubdivisionMandelCalculator.cc
+ * @author Matěj Konopík <xkonop03@stud.fit.vutbr.cz>
+ * @brief Mandelbrot calculator evaluating rectangle borders only and filling the uniform ones (Mariani-Silver)
+ * @date 16.10.2026
+ */
+
+#include <iostream>
+#include <cstdlib>
+
+#include "SubdivisionMandelCalculator.h"
+
+using std::cout;
+using std::cerr;
+using std::endl;
+
+#define ALIGN_SIZE 64                           // align memory to 64 bytes (for the AVX512 registers: 64B = 512b)
+#define SUBDIVISION_TILE 16                     // rectangles narrower than this are calculated cell by cell
+#define SUBDIVISION_MEM_ALLOC_ERR 6000          // error code for memory allocation failure
+
+
+//#define DEBUG   // uncomment this line to enable debug printing
+#ifdef DEBUG
+#define D_PRINT(x) std::cout << "SUBDIVISION_DEBUG: " << x << std::endl
+#else
+#define D_PRINT(x)
+#endif
+
+
+template <typename T>
+SubdivisionMandelCalculator<T>::SubdivisionMandelCalculator(unsigned matrixBaseSize, unsigned limit) :
+        BaseMandelCalculator(matrixBaseSize, limit, std::string("SubdivisionMandelCalculator<") + precisionName<T>() + ">"),
+        cell_count(0), evaluated(0) {
+    // pick the kernel compiled for the ISA selected at startup
+    kernel = ISA_DISPATCH(selectedIsa(), calculateBatchPoints<T>);
+    isaVariant = isaName(selectedIsa());
+    // we use the fact that mandelbrot is symmetrical, therefore we only calculate half and then copy it
+    half_height = calculatedHeight();
+    first_row = calculatedFirstRow();
+    // the queue holds the border of the whole half or the inside of a rectangle narrower than the tile
+    cell_capacity = (SUBDIVISION_TILE + 2) * (width + half_height);
+    // allocate main data matrix
+    data = (int *) (aligned_alloc(ALIGN_SIZE, height * width * sizeof(int)));
+    // allocate helper arrays
+    cells = (int *) (aligned_alloc(ALIGN_SIZE, cell_capacity * sizeof(int)));
+    cell_values = (int *) (aligned_alloc(ALIGN_SIZE, cell_capacity * sizeof(int)));
+    c_x_temp = (T *) (aligned_alloc(ALIGN_SIZE, cell_capacity * sizeof(T)));
+    c_y_temp = (T *) (aligned_alloc(ALIGN_SIZE, cell_capacity * sizeof(T)));
+    z_x_temp = (T *) (aligned_alloc(ALIGN_SIZE, BATCH_SIZE * sizeof(T)));
+    z_y_temp = (T *) (aligned_alloc(ALIGN_SIZE, BATCH_SIZE * sizeof(T)));
+    // check allocation success
+    if (data == nullptr or cells == nullptr or cell_values == nullptr or c_x_temp == nullptr or
+        c_y_temp == nullptr or z_x_temp == nullptr or z_y_temp == nullptr) {
+        cerr << typeid(*this).name() << " : Memory allocation failed. Aborting." << endl;
+        exit(SUBDIVISION_MEM_ALLOC_ERR);
+    }
+    D_PRINT(typeid(*this).name() << " : half_height=" << half_height
+                                 << " height=" << height
+                                 << " width=" << width
+                                 << " limit=" << limit
+                                 << endl);
+}
+
+template <typename T>
+SubdivisionMandelCalculator<T>::~SubdivisionMandelCalculator() {
+    // free allocated data with checking against the memory validity
+    if (data != nullptr) {
+        free(data);
+    }
+    if (cells != nullptr) {
+        free(cells);
+    }
+    if (cell_values != nullptr) {
+        free(cell_values);
+    }
+    if (c_x_temp != nullptr) {
+        free(c_x_temp);
+    }
+    if (c_y_temp != nullptr) {
+        free(c_y_temp);
+    }
+    if (z_x_temp != nullptr) {
+        free(z_x_temp);
+    }
+    if (z_y_temp != nullptr) {
+        free(z_y_temp);
+    }
+}
+
+
+template <typename T>
+void SubdivisionMandelCalculator<T>::queueCell(int x_index, int y_index) {
+    const int index = y_index * width + x_index;
+    if (data[index] != CELL_PENDING) {
+        return;
+    }
+    cells[cell_count] = index;
+    c_x_temp[cell_count] = T(x_start + x_index * dx);
+    c_y_temp[cell_count] = T(yValue(y_index));
+    cell_count++;
+}
+
+template <typename T>
+void SubdivisionMandelCalculator<T>::evaluateQueued() {
+    if (cell_count == 0) {
+        return;
+    }
+    kernel(cell_values, c_x_temp, c_y_temp, cell_count, z_x_temp, z_y_temp, limit);
+    for (auto i = 0; i < cell_count; i++) {
+        data[cells[i]] = cell_values[i];
+    }
+    evaluated += cell_count;
+    cell_count = 0;
+}
+
+template <typename T>
+void SubdivisionMandelCalculator<T>::subdivide(int x_0, int y_0, int x_1, int y_1) {
+    // evaluate the border of the rectangle, the parts shared with the neighbours are known already
+    for (auto x_index = x_0; x_index <= x_1; x_index++) {
+        queueCell(x_index, y_0);
+        if (y_1 > y_0) {
+            queueCell(x_index, y_1);
+        }
+    }
+    for (auto y_index = y_0 + 1; y_index < y_1; y_index++) {
+        queueCell(x_0, y_index);
+        if (x_1 > x_0) {
+            queueCell(x_1, y_index);
+        }
+    }
+    evaluateQueued();
+
+    // a rectangle with a uniform border is uniform inside as well
+    const int value = data[y_0 * width + x_0];
+    bool uniform = true;
+    for (auto x_index = x_0; x_index <= x_1 and uniform; x_index++) {
+        uniform = data[y_0 * width + x_index] == value and data[y_1 * width + x_index] == value;
+    }
+    for (auto y_index = y_0 + 1; y_index < y_1 and uniform; y_index++) {
+        uniform = data[y_index * width + x_0] == value and data[y_index * width + x_1] == value;
+    }
+    if (uniform) {
+        for (auto y_index = y_0 + 1; y_index < y_1; y_index++) {
+            for (auto x_index = x_0 + 1; x_index < x_1; x_index++) {
+                int &cell = data[y_index * width + x_index];
+                cell = cell == CELL_PENDING ? value : cell;
+            }
+        }
+        return;
+    }
+
+    // small rectangles are cheaper to calculate whole than to split further
+    if (x_1 - x_0 < SUBDIVISION_TILE or y_1 - y_0 < SUBDIVISION_TILE) {
+        for (auto y_index = y_0 + 1; y_index < y_1; y_index++) {
+            for (auto x_index = x_0 + 1; x_index < x_1; x_index++) {
+                queueCell(x_index, y_index);
+            }
+        }
+        evaluateQueued();
+        return;
+    }
+
+    // split into quadrants sharing the middle row and column
+    const int x_mid = (x_0 + x_1) / 2;
+    const int y_mid = (y_0 + y_1) / 2;
+    subdivide(x_0, y_0, x_mid, y_mid);
+    subdivide(x_mid, y_0, x_1, y_mid);
+    subdivide(x_0, y_mid, x_mid, y_1);
+    subdivide(x_mid, y_mid, x_1, y_1);
+}
+
+
+template <typename T>
+int *SubdivisionMandelCalculator<T>::calculateMandelbrot() {
+    resetPrepared();
+    evaluated = 0;
+
+    // mark the lines not mirrored from other ones as not calculated yet (or classify them)
+    for (auto y_index = first_row; y_index < first_row + half_height; y_index++) {
+        prepareLine(data + y_index * width, y_index);
+    }
+
+    subdivide(0, first_row, width - 1, first_row + half_height - 1);
+    D_PRINT("evaluated: " << evaluated);
+
+    // copy the calculated lines to the lines mirroring them across the real axis (a window is not mirrored)
+    mirrorLines(data);
+    return data;
+}
+
+template <typename T>
+void SubdivisionMandelCalculator<T>::report(std::ostream &cout, bool batchMode) {
+    BaseMandelCalculator::report(cout, batchMode);
+    if (batchMode) {
+        return;
+    }
+    cout << "Evaluated cells:   " << evaluated << " ("
+         << 100.0 * evaluated / ((long) half_height * width) << " % of the calculated lines)" << endl;
+}
+
+template <typename T>
+long SubdivisionMandelCalculator<T>::evaluatedCells() {
+    return evaluated;
+}
+
+template class SubdivisionMandelCalculator<float>;
+template class SubdivisionMandelCalculator<double>;
@@ -0,0 +1,58 @@
+/**
+ * @file SubdivisionMandelCalculator.h
+ * @author Matěj Konopík <xkonop03@stud.fit.vutbr.cz>
+ * @brief Mandelbrot calculator evaluating rectangle borders only and filling the uniform ones (Mariani-Silver)
+ * @date 16.10.2026
+ */
+#ifndef SUBDIVISIONMANDELCALCULATOR_H
+#define SUBDIVISIONMANDELCALCULATOR_H
+
+#include <BaseMandelCalculator.h>
+#include "BatchMandelKernel.h"
+
+/**
+ * @tparam T floating point type to iterate in (float or double)
+ */
+template <typename T>
+class SubdivisionMandelCalculator : public BaseMandelCalculator
+{
+public:
+    SubdivisionMandelCalculator(unsigned matrixBaseSize, unsigned limit);
+    ~SubdivisionMandelCalculator();
+    int *calculateMandelbrot();
+    void report(std::ostream &cout, bool batchMode);
+    long evaluatedCells();
+
+private:
+    int* data;
+    int* cells;                 // indices of the cells waiting for the kernel
+    int* cell_values;
+    T* c_x_temp;                // coordinates of the cells waiting for the kernel
+    T* c_y_temp;
+    T* z_x_temp;
+    T* z_y_temp;
+    int cell_count;
+    int cell_capacity;
+    int half_height;
+    int first_row;      // first calculated line, see BaseMandelCalculator::calculatedFirstRow
+    long evaluated;
+
+    decltype(&isa_sse42::calculateBatchPoints<T>) kernel;  // point kernel compiled for the selected ISA
+
+    /**
+     * @brief Queues the cell for the kernel unless it is already known
+     */
+    void queueCell(int x_index, int y_index);
+
+    /**
+     * @brief Evaluates the queued cells and writes them to the matrix
+     */
+    void evaluateQueued();
+
+    /**
+     * @brief Calculates the rectangle with the corners [x_0, y_0] and [x_1, y_1] (inclusive)
+     */
+    void subdivide(int x_0, int y_0, int x_1, int y_1);
+};
+
+#endif
@@ -0,0 +1,184 @@
+/**
+ * @file TiledMandelCalculator.cc
+ * @author Matěj Konopík <xkonop03@stud.fit.vutbr.cz>
+ * @brief Mandelbrot calculator that uses SIMD parallelization over small 2D tiles
+ * @date 16.10.2026
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+#include <type_traits>
+
+#include "TiledMandelCalculator.h"
+
+using std::cout;
+using std::cerr;
+using std::endl;
+
+#define ALIGN_SIZE 64                           // align memory to 64 bytes (for the AVX512 registers: 64B = 512b)
+#define TILED_MEM_ALLOC_ERR 8000                // error code for memory allocation failure
+#define TILED_UNROLL_ERR 8001                   // error code for an unroll factor without a compiled kernel
+#define TILED_BLOCK_TILES 4                     // tiles per side of one block scheduled by the pool
+#define TILED_BAND_BLOCKS 2                     // block lines per thread of one band of a narrow matrix
+
+
+//#define DEBUG   // uncomment this line to enable debug printing
+#ifdef DEBUG
+#define D_PRINT(x) std::cout << "TILED_DEBUG: " << x << std::endl
+#else
+#define D_PRINT(x)
+#endif
+
+
+template <typename T, typename E>
+TiledMandelCalculator<T, E>::TiledMandelCalculator(unsigned matrixBaseSize, unsigned limit, int unroll) :
+        BaseMandelCalculator(matrixBaseSize, limit, std::string("TiledMandelCalculator<") + precisionName<T>() + ">("
+                                                    + std::to_string(TILE_WIDTH) + "x" + std::to_string(TILE_HEIGHT)
+                                                    + (unroll ? ",K=" + std::to_string(unroll) : "")
+                                                    + (std::is_same<E, int>::value ? ""
+                                                       : std::string(", ") + storageName<E>())
+                                                    + ")"),
+        unroll(unroll), unroll_stats({0, 0}), worker_unroll_stats(threads) {
+    // pick the kernels compiled for the ISA selected at startup
+    kernel = ISA_DISPATCH(selectedIsa(), calculateTile<T>);
+    switch (unroll) {
+        case 0:
+            unrolled_kernel = nullptr;
+            break;
+        case 4:
+            unrolled_kernel = ISA_DISPATCH(selectedIsa(), calculateTileUnrolled<T, 4>);
+            break;
+        case 8:
+            unrolled_kernel = ISA_DISPATCH(selectedIsa(), calculateTileUnrolled<T, 8>);
+            break;
+        case 16:
+            unrolled_kernel = ISA_DISPATCH(selectedIsa(), calculateTileUnrolled<T, 16>);
+            break;
+        default:
+            cerr << typeid(*this).name() << " : Unsupported unroll factor " << unroll << ". Aborting." << endl;
+            exit(TILED_UNROLL_ERR);
+    }
+    isaVariant = isaName(selectedIsa());
+    // we use the fact that mandelbrot is symmetrical, therefore we only calculate half and then copy it
+    half_height = calculatedHeight();
+    first_row = calculatedFirstRow();
+    // an int matrix is calculated in place at once, a narrow one in bands of int lines narrowed into it
+    const int block_height = TILED_BLOCK_TILES * TILE_HEIGHT;
+    const bool narrow = !std::is_same<E, int>::value;
+    band_height = narrow && TILED_BAND_BLOCKS * threads * block_height < half_height
+                  ? TILED_BAND_BLOCKS * threads * block_height : half_height;
+    // allocate main data matrix
+    data = (E *) (aligned_alloc(ALIGN_SIZE, height * width * sizeof(E)));
+    band_temp = narrow ? (int *) (aligned_alloc(ALIGN_SIZE, ((size_t)band_height * width * sizeof(int)
+                                                              + ALIGN_SIZE - 1) / ALIGN_SIZE * ALIGN_SIZE))
+                       : nullptr;
+    // check allocation success
+    if (data == nullptr || (narrow && band_temp == nullptr)) {
+        cerr << typeid(*this).name() << " : Memory allocation failed. Aborting." << endl;
+        exit(TILED_MEM_ALLOC_ERR);
+    }
+    D_PRINT(typeid(*this).name() << " : half_height=" << half_height
+                                 << " height=" << height
+                                 << " width=" << width
+                                 << " limit=" << limit
+                                 << endl);
+}
+
+template <typename T, typename E>
+TiledMandelCalculator<T, E>::~TiledMandelCalculator() {
+    // free allocated data with checking against the memory validity
+    if (data != nullptr) {
+        free(data);
+    }
+    if (band_temp != nullptr) {
+        free(band_temp);
+    }
+}
+
+
+template <typename T, typename E>
+E *TiledMandelCalculator<T, E>::calculateMandelbrot() {
+    resetPrepared();
+    unroll_stats = {0, 0};
+
+    WorkStealingPool &pool = WorkStealingPool::shared(threads);
+    pool.resetStats();
+    for (auto &stats : worker_unroll_stats) {
+        stats = {0, 0};
+    }
+
+    const int block_width = TILED_BLOCK_TILES * TILE_WIDTH;
+    const int block_height = TILED_BLOCK_TILES * TILE_HEIGHT;
+    for (auto band_row = first_row; band_row < first_row + half_height; band_row += band_height) {
+        const int band_rows = band_row + band_height < first_row + half_height
+                              ? band_height : first_row + half_height - band_row;
+        int *lines = countLine(data, band_row, band_temp);
+
+        // classify the lines of the band before the tiles are scheduled
+#pragma omp parallel for schedule(static)
+        for (auto y_index = 0; y_index < band_rows; y_index++) {
+            prepareLine(lines + y_index * width, band_row + y_index);
+        }
+
+        // the pool splits the lines of the band into blocks of tiles and balances them over the workers by
+        // stealing, the tiles are placed relative to the first line of the band
+        const int image_row = rowOffset + band_row;
+        pool.run((width + block_width - 1) / block_width, (band_rows + block_height - 1) / block_height,
+                 [&](int block_x, int block_y, int worker) {
+            const int x_end = (block_x + 1) * block_width < width ? (block_x + 1) * block_width : width;
+            const int y_end = (block_y + 1) * block_height < band_rows ? (block_y + 1) * block_height : band_rows;
+            for (auto y_tile = block_y * block_height; y_tile < y_end; y_tile += TILE_HEIGHT) {
+                // the last tile of the line may reach past its end, the kernel masks it
+                for (auto x_tile = block_x * block_width; x_tile < x_end; x_tile += TILE_WIDTH) {
+                    if (unroll) {
+                        UnrollStats stats = unrolled_kernel(lines, width, band_rows, image_row, x_tile, y_tile,
+                                                            x_start, dx, y_start, dy, limit);
+                        worker_unroll_stats[worker].blocks += stats.blocks;
+                        worker_unroll_stats[worker].rollbacks += stats.rollbacks;
+                    } else {
+                        kernel(lines, width, band_rows, image_row, x_tile, y_tile, x_start, dx, y_start, dy, limit);
+                    }
+                }
+            }
+        });
+
+#pragma omp parallel for schedule(static)
+        for (auto y_index = 0; y_index < band_rows; y_index++) {
+            storeLine(data, band_row + y_index, lines + y_index * width);
+        }
+    }
+    for (const auto &stats : worker_unroll_stats) {
+        unroll_stats.blocks += stats.blocks;
+        unroll_stats.rollbacks += stats.rollbacks;
+    }
+
+    // copy the calculated lines to the lines mirroring them across the real axis (a window is not mirrored)
+    mirrorLines(data);
+    return data;
+}
+
+template <typename T, typename E>
+void TiledMandelCalculator<T, E>::report(std::ostream &cout, bool batchMode) {
+    BaseMandelCalculator::report(cout, batchMode);
+    if (batchMode) {
+        return;
+    }
+    if (unroll) {
+        cout << "Unchecked blocks:  " << unroll_stats.blocks << ", " << unroll_stats.rollbacks << " rolled back ("
+             << (unroll_stats.blocks ? 100.0 * unroll_stats.rollbacks / unroll_stats.blocks : 0.0) << " %)" << endl;
+    }
+    const WorkStealingPool &pool = WorkStealingPool::shared(threads);
+    for (auto worker = 0; worker < pool.workers(); worker++) {
+        const WorkStealingPool::WorkerStats &stats = pool.stats(worker);
+        cout << "Pool worker " << std::left << std::setw(7) << std::to_string(worker) + ":" << std::right << stats.blocks << " blocks, " << stats.steals << " steals, "
+             << stats.failedSteals << " failed steals, " << stats.idleTime << " ms idle" << endl;
+    }
+}
+
+template class TiledMandelCalculator<float, uint8_t>;
+template class TiledMandelCalculator<float, uint16_t>;
+template class TiledMandelCalculator<float, int>;
+template class TiledMandelCalculator<double, uint8_t>;
+template class TiledMandelCalculator<double, uint16_t>;
+template class TiledMandelCalculator<double, int>;
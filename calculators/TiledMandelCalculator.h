@@ -0,0 +1,43 @@
+/**
+ * @file TiledMandelCalculator.h
+ * @author Matěj Konopík <xkonop03@stud.fit.vutbr.cz>
+ * @brief Mandelbrot calculator that uses SIMD parallelization over small 2D tiles
+ * @date 16.10.2026
+ */
+#ifndef TILEDMANDELCALCULATOR_H
+#define TILEDMANDELCALCULATOR_H
+
+#include <BaseMandelCalculator.h>
+#include "TiledMandelKernel.h"
+#include "work_stealing_pool.h"
+
+/**
+ * @tparam T floating point type to iterate in (float or double)
+ * @tparam E element type of the count matrix (uint8_t, uint16_t or int), see storageFor
+ */
+template <typename T, typename E = int>
+class TiledMandelCalculator : public BaseMandelCalculator
+{
+public:
+    /**
+     * @param unroll number of iterations between two escape checks (4, 8 or 16), 0 checks every iteration
+     */
+    TiledMandelCalculator(unsigned matrixBaseSize, unsigned limit, int unroll = 0);
+    ~TiledMandelCalculator();
+    E *calculateMandelbrot();
+    void report(std::ostream &cout, bool batchMode);
+
+private:
+    E* data;
+    int* band_temp;     // lines the counts of a narrow matrix are calculated in, see countLine
+    int band_height;    // lines calculated at once, all of them for an int matrix
+    int half_height;
+    int first_row;      // first calculated line, see BaseMandelCalculator::calculatedFirstRow
+    int unroll;
+    UnrollStats unroll_stats;
+    std::vector<UnrollStats> worker_unroll_stats;   // unroll statistics of every pool worker
+    decltype(&isa_sse42::calculateTile<T>) kernel;  // tile kernel compiled for the selected ISA
+    decltype(&isa_sse42::calculateTileUnrolled<T, 4>) unrolled_kernel;
+};
+
+#endif
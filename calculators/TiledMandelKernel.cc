@@ -0,0 +1,195 @@
+/**
+ * @file TiledMandelKernel.cc
+ * @author Matěj Konopík <xkonop03@stud.fit.vutbr.cz>
+ * @brief Vectorized kernel of the tiled calculator, compiled once per supported ISA
+ * @date 16.10.2026
+ */
+
+#include "TiledMandelKernel.h"
+
+#ifndef MANDEL_ISA_NS
+#error "Kernels are compiled through the per-ISA object libraries only"
+#endif
+
+namespace MANDEL_ISA_NS {
+
+template <typename T>
+void calculateTile(int *data, int width, int rows, int first_row, int x_tile, int y_tile,
+                   double x_start, double dx, double y_start, double dy, int limit) {
+    // the tile state is local, so that the compiler can keep it in the registers
+    alignas(64) T c_x[TILE_CELLS];
+    alignas(64) T c_y[TILE_CELLS];
+    alignas(64) T z_x[TILE_CELLS];
+    alignas(64) T z_y[TILE_CELLS];
+    alignas(64) int value[TILE_CELLS];
+
+    // load the tile, the cells outside of the matrix are masked off as already known
+    for (int tile_index = 0; tile_index < TILE_CELLS; tile_index++) {
+        const int x_index = x_tile + tile_index % TILE_WIDTH;
+        const int y_index = y_tile + tile_index / TILE_WIDTH;
+        value[tile_index] = x_index < width && y_index < rows ? data[y_index * width + x_index] : 0;
+    }
+#pragma omp simd simdlen(simdLen<T>())
+    for (int tile_index = 0; tile_index < TILE_CELLS; tile_index++) {
+        c_x[tile_index] = T(x_start + (x_tile + tile_index % TILE_WIDTH) * dx);
+        c_y[tile_index] = T(y_start + (first_row + y_tile + tile_index / TILE_WIDTH) * dy);
+        z_x[tile_index] = c_x[tile_index];
+        z_y[tile_index] = c_y[tile_index];
+    }
+
+    // calculate the mandelbrot values for the current tile
+    for (int iteration = 0; iteration < limit; iteration++) {
+        // number of cells that are still iterating, the tile is done once there are none
+        int active = 0;
+#pragma omp simd simdlen(simdLen<T>()) reduction(+:active)
+        for (int tile_index = 0; tile_index < TILE_CELLS; tile_index++) {
+            if (value[tile_index] == CELL_PENDING) {
+                T z_x_value = z_x[tile_index];
+                T z_y_value = z_y[tile_index];
+
+                T z_x2 = z_x_value * z_x_value;
+                T z_y2 = z_y_value * z_y_value;
+
+                if (z_x2 + z_y2 > T(4)) {
+                    value[tile_index] = iteration;
+                } else {
+                    z_y[tile_index] = T(2) * z_x_value * z_y_value + c_y[tile_index];
+                    z_x[tile_index] = z_x2 - z_y2 + c_x[tile_index];
+                    active++;
+                }
+            }
+        }
+        if (!active) break;
+    }
+
+    // store the tile, the cells that did not escape are in the set
+    for (int tile_index = 0; tile_index < TILE_CELLS; tile_index++) {
+        const int x_index = x_tile + tile_index % TILE_WIDTH;
+        const int y_index = y_tile + tile_index / TILE_WIDTH;
+        if (x_index < width && y_index < rows) {
+            data[y_index * width + x_index] = value[tile_index] == CELL_PENDING ? limit : value[tile_index];
+        }
+    }
+}
+
+template <typename T, int K>
+UnrollStats calculateTileUnrolled(int *data, int width, int rows, int first_row, int x_tile, int y_tile,
+                                  double x_start, double dx, double y_start, double dy, int limit) {
+    // the tile state is local, so that the compiler can keep it in the registers
+    alignas(64) T c_x[TILE_CELLS];
+    alignas(64) T c_y[TILE_CELLS];
+    alignas(64) T z_x_buffers[2][TILE_CELLS];
+    alignas(64) T z_y_buffers[2][TILE_CELLS];
+    alignas(64) int value[TILE_CELLS];
+    UnrollStats stats = {0, 0};
+
+    // load the tile, the cells outside of the matrix are masked off as already known
+    int active = 0;
+    for (int tile_index = 0; tile_index < TILE_CELLS; tile_index++) {
+        const int x_index = x_tile + tile_index % TILE_WIDTH;
+        const int y_index = y_tile + tile_index / TILE_WIDTH;
+        value[tile_index] = x_index < width && y_index < rows ? data[y_index * width + x_index] : 0;
+        active += value[tile_index] == CELL_PENDING;
+    }
+    T *z_x = z_x_buffers[0];
+    T *z_y = z_y_buffers[0];
+    T *next_x = z_x_buffers[1];
+    T *next_y = z_y_buffers[1];
+#pragma omp simd simdlen(simdLen<T>())
+    for (int tile_index = 0; tile_index < TILE_CELLS; tile_index++) {
+        c_x[tile_index] = T(x_start + (x_tile + tile_index % TILE_WIDTH) * dx);
+        c_y[tile_index] = T(y_start + (first_row + y_tile + tile_index / TILE_WIDTH) * dy);
+        z_x[tile_index] = c_x[tile_index];
+        z_y[tile_index] = c_y[tile_index];
+    }
+
+    int iteration = 0;
+    while (active && iteration < limit) {
+        // run a block of K iterations without the checks, tracking the largest |z|^2 of every cell
+        if (iteration + K <= limit) {
+            alignas(64) T peak[TILE_CELLS];
+#pragma omp simd simdlen(simdLen<T>())
+            for (int tile_index = 0; tile_index < TILE_CELLS; tile_index++) {
+                next_x[tile_index] = z_x[tile_index];
+                next_y[tile_index] = z_y[tile_index];
+                peak[tile_index] = T(0);
+            }
+            for (int step = 0; step < K; step++) {
+#pragma omp simd simdlen(simdLen<T>())
+                for (int tile_index = 0; tile_index < TILE_CELLS; tile_index++) {
+                    T z_x_value = next_x[tile_index];
+                    T z_y_value = next_y[tile_index];
+
+                    T z_x2 = z_x_value * z_x_value;
+                    T z_y2 = z_y_value * z_y_value;
+
+                    peak[tile_index] = z_x2 + z_y2 > peak[tile_index] ? z_x2 + z_y2 : peak[tile_index];
+                    next_y[tile_index] = T(2) * z_x_value * z_y_value + c_y[tile_index];
+                    next_x[tile_index] = z_x2 - z_y2 + c_x[tile_index];
+                }
+            }
+            int escaped = 0;
+#pragma omp simd simdlen(simdLen<T>()) reduction(+:escaped)
+            for (int tile_index = 0; tile_index < TILE_CELLS; tile_index++) {
+                escaped += value[tile_index] == CELL_PENDING && peak[tile_index] > T(4);
+            }
+            stats.blocks++;
+
+            // no cell escaped, the block is committed
+            if (!escaped) {
+                T *swap_x = z_x; z_x = next_x; next_x = swap_x;
+                T *swap_y = z_y; z_y = next_y; next_y = swap_y;
+                iteration += K;
+                continue;
+            }
+            // roll back to the state the block started from, it is still in z_x and z_y
+            stats.rollbacks++;
+        }
+
+        // replay the block (or run the tail shorter than K) with the checks
+        const int block_end = iteration + K < limit ? iteration + K : limit;
+        for (; iteration < block_end; iteration++) {
+            active = 0;
+#pragma omp simd simdlen(simdLen<T>()) reduction(+:active)
+            for (int tile_index = 0; tile_index < TILE_CELLS; tile_index++) {
+                if (value[tile_index] == CELL_PENDING) {
+                    T z_x_value = z_x[tile_index];
+                    T z_y_value = z_y[tile_index];
+
+                    T z_x2 = z_x_value * z_x_value;
+                    T z_y2 = z_y_value * z_y_value;
+
+                    if (z_x2 + z_y2 > T(4)) {
+                        value[tile_index] = iteration;
+                    } else {
+                        z_y[tile_index] = T(2) * z_x_value * z_y_value + c_y[tile_index];
+                        z_x[tile_index] = z_x2 - z_y2 + c_x[tile_index];
+                        active++;
+                    }
+                }
+            }
+            if (!active) break;
+        }
+    }
+
+    // store the tile, the cells that did not escape are in the set
+    for (int tile_index = 0; tile_index < TILE_CELLS; tile_index++) {
+        const int x_index = x_tile + tile_index % TILE_WIDTH;
+        const int y_index = y_tile + tile_index / TILE_WIDTH;
+        if (x_index < width && y_index < rows) {
+            data[y_index * width + x_index] = value[tile_index] == CELL_PENDING ? limit : value[tile_index];
+        }
+    }
+    return stats;
+}
+
+template void calculateTile<float>(int *, int, int, int, int, int, double, double, double, double, int);
+template void calculateTile<double>(int *, int, int, int, int, int, double, double, double, double, int);
+template UnrollStats calculateTileUnrolled<float, 4>(int *, int, int, int, int, int, double, double, double, double, int);
+template UnrollStats calculateTileUnrolled<float, 8>(int *, int, int, int, int, int, double, double, double, double, int);
+template UnrollStats calculateTileUnrolled<float, 16>(int *, int, int, int, int, int, double, double, double, double, int);
+template UnrollStats calculateTileUnrolled<double, 4>(int *, int, int, int, int, int, double, double, double, double, int);
+template UnrollStats calculateTileUnrolled<double, 8>(int *, int, int, int, int, int, double, double, double, double, int);
+template UnrollStats calculateTileUnrolled<double, 16>(int *, int, int, int, int, int, double, double, double, double, int);
+
+}
@@ -0,0 +1,62 @@
+/**
+ * @file TiledMandelKernel.h
+ * @author Matěj Konopík <xkonop03@stud.fit.vutbr.cz>
+ * @brief Vectorized kernel of the tiled calculator, compiled once per supported ISA
+ * @date 16.10.2026
+ */
+#ifndef TILEDMANDELKERNEL_H
+#define TILEDMANDELKERNEL_H
+
+#include "isa_dispatch.h"
+#include "ClassifierKernel.h"
+
+// tile shape, selected at compile time (cmake -DMANDEL_TILE_WIDTH=16 -DMANDEL_TILE_HEIGHT=4)
+#ifndef TILE_WIDTH
+#define TILE_WIDTH 8                            // number of columns of one tile
+#endif
+#ifndef TILE_HEIGHT
+#define TILE_HEIGHT 8                           // number of lines of one tile
+#endif
+#define TILE_CELLS (TILE_WIDTH * TILE_HEIGHT)
+
+/**
+ * @brief Block counters of the unrolled tile kernel
+ */
+struct UnrollStats {
+    long blocks;                                // blocks of K iterations run without the escape checks
+    long rollbacks;                             // blocks replayed with the checks because a cell escaped in them
+};
+
+ISA_DECLARE(
+    /**
+     * @brief Calculates one TILE_WIDTH x TILE_HEIGHT tile of the matrix
+     *
+     * The parts of the tile outside of the matrix are masked off, the tile stops iterating once
+     * all of its cells escaped.
+     *
+     * @param data output matrix (width cells per line), only its CELL_PENDING cells are calculated
+     * @param rows number of the lines of the matrix to calculate
+     * @param first_row line of the image the first line of data belongs to (at y_start + first_row * dy)
+     * @param x_tile index of the first column of the tile
+     * @param y_tile index of the first line of the tile
+     * @tparam T floating point type to iterate in
+     */
+    template <typename T>
+    void calculateTile(int *data, int width, int rows, int first_row, int x_tile, int y_tile,
+                       double x_start, double dx, double y_start, double dy, int limit);
+
+    /**
+     * @brief Calculates one tile like calculateTile, checking the escape once per K iterations only
+     *
+     * A block of K iterations runs without the escape checks, it is rolled back to the state it started
+     * from and replayed with the checks when any cell escaped inside of it, so the values stay exact.
+     *
+     * @tparam K number of iterations of one block (4, 8 or 16)
+     * @return block counters
+     */
+    template <typename T, int K>
+    UnrollStats calculateTileUnrolled(int *data, int width, int rows, int first_row, int x_tile, int y_tile,
+                                      double x_start, double dx, double y_start, double dy, int limit);
+)
+
+#endif
@@ -0,0 +1,200 @@
+/**
+ * @file    fixed_point.h
+ *
+ * @authors Matěj Konopík <xkonop03@stud.fit.vutbr.cz>
+ *
+ * @brief   Signed multi-limb fixed point number used for the high precision reference orbits
+ *
+ *          The magnitude is stored big-endian in 64-bit limbs, limb 0 holds the integer part and
+ *          the remaining FRAC_LIMBS limbs the fraction (FRAC_LIMBS * 64 bits of precision).
+ *
+ * @date    16 October 2026
+ **/
+
+#ifndef FIXED_POINT_H
+#define FIXED_POINT_H
+
+#include <cstdint>
+#include <cmath>
+#include <string>
+#include <stdexcept>
+
+template <int FRAC_LIMBS>
+class FixedPoint
+{
+public:
+    static const int LIMBS = FRAC_LIMBS + 1;
+
+    FixedPoint() : negative(false)
+    {
+        for (int i = 0; i < LIMBS; i++)
+            mag[i] = 0;
+    }
+
+    /**
+     * @brief Exact conversion from double (the integer part has to fit into 64 bits)
+     */
+    explicit FixedPoint(double value) : FixedPoint()
+    {
+        negative = value < 0.0;
+        value = std::fabs(value);
+        double integer = std::floor(value);
+        mag[0] = (uint64_t)integer;
+        value -= integer;
+        for (int i = 1; i < LIMBS && value != 0.0; i++)
+        {
+            value = std::ldexp(value, 64);
+            integer = std::floor(value);
+            mag[i] = (uint64_t)integer;
+            value -= integer;
+        }
+    }
+
+    /**
+     * @brief Parses decimal number in the form [-]123.456 (rounded towards zero)
+     */
+    static FixedPoint fromString(const std::string &text)
+    {
+        FixedPoint result;
+        size_t pos = 0;
+        if (pos < text.size() && (text[pos] == '-' || text[pos] == '+'))
+            result.negative = text[pos++] == '-';
+
+        size_t point = text.find('.', pos);
+        std::string integer = text.substr(pos, point == std::string::npos ? std::string::npos : point - pos);
+        std::string fraction = point == std::string::npos ? "" : text.substr(point + 1);
+        if (integer.empty() && fraction.empty())
+            throw std::invalid_argument("Invalid number: " + text);
+
+        for (char digit : integer)
+        {
+            if (digit < '0' || digit > '9')
+                throw std::invalid_argument("Invalid number: " + text);
+            result.mag[0] = result.mag[0] * 10 + (digit - '0');
+        }
+        // the fraction is accumulated from the least significant digit: f = (d + f) / 10
+        uint64_t whole = result.mag[0];
+        result.mag[0] = 0;
+        for (size_t i = fraction.size(); i-- > 0;)
+        {
+            if (fraction[i] < '0' || fraction[i] > '9')
+                throw std::invalid_argument("Invalid number: " + text);
+            result.mag[0] = fraction[i] - '0';
+            result.divideSmall(10);
+        }
+        result.mag[0] = whole;
+        return result;
+    }
+
+    double toDouble() const
+    {
+        double value = 0.0;
+        for (int i = LIMBS - 1; i >= 0; i--)
+            value = value / 18446744073709551616.0 + (double)mag[i];
+        return negative ? -value : value;
+    }
+
+    FixedPoint operator-() const
+    {
+        FixedPoint result = *this;
+        result.negative = !negative;
+        return result;
+    }
+
+    FixedPoint operator+(const FixedPoint &other) const
+    {
+        if (negative == other.negative)
+        {
+            FixedPoint result = *this;
+            result.addMagnitude(other);
+            return result;
+        }
+        // different signs, subtract the smaller magnitude from the larger one
+        if (compareMagnitude(other) >= 0)
+        {
+            FixedPoint result = *this;
+            result.subMagnitude(other);
+            return result;
+        }
+        FixedPoint result = other;
+        result.subMagnitude(*this);
+        return result;
+    }
+
+    FixedPoint operator-(const FixedPoint &other) const
+    {
+        return *this + (-other);
+    }
+
+    FixedPoint operator*(const FixedPoint &other) const
+    {
+        // full product of the magnitudes, little-endian limbs
+        uint64_t product[2 * LIMBS] = {0};
+        for (int i = LIMBS - 1; i >= 0; i--)
+        {
+            unsigned __int128 carry = 0;
+            for (int j = LIMBS - 1; j >= 0; j--)
+            {
+                int k = (LIMBS - 1 - i) + (LIMBS - 1 - j);
+                unsigned __int128 t = (unsigned __int128)mag[i] * other.mag[j] + product[k] + carry;
+                product[k] = (uint64_t)t;
+                carry = t >> 64;
+            }
+            product[(LIMBS - 1 - i) + LIMBS] += (uint64_t)carry;
+        }
+        // drop the FRAC_LIMBS least significant limbs (truncation)
+        FixedPoint result;
+        for (int i = 0; i < LIMBS; i++)
+            result.mag[LIMBS - 1 - i] = product[i + FRAC_LIMBS];
+        result.negative = negative != other.negative;
+        return result;
+    }
+
+private:
+    bool negative;
+    uint64_t mag[LIMBS];
+
+    int compareMagnitude(const FixedPoint &other) const
+    {
+        for (int i = 0; i < LIMBS; i++)
+            if (mag[i] != other.mag[i])
+                return mag[i] < other.mag[i] ? -1 : 1;
+        return 0;
+    }
+
+    void addMagnitude(const FixedPoint &other)
+    {
+        unsigned __int128 carry = 0;
+        for (int i = LIMBS - 1; i >= 0; i--)
+        {
+            unsigned __int128 t = (unsigned __int128)mag[i] + other.mag[i] + carry;
+            mag[i] = (uint64_t)t;
+            carry = t >> 64;
+        }
+    }
+
+    // requires |this| >= |other|
+    void subMagnitude(const FixedPoint &other)
+    {
+        uint64_t borrow = 0;
+        for (int i = LIMBS - 1; i >= 0; i--)
+        {
+            uint64_t sub = other.mag[i] + borrow;
+            borrow = (sub < borrow) || (mag[i] < sub) ? 1 : 0;
+            mag[i] -= sub;
+        }
+    }
+
+    void divideSmall(uint64_t divisor)
+    {
+        unsigned __int128 remainder = 0;
+        for (int i = 0; i < LIMBS; i++)
+        {
+            unsigned __int128 t = (remainder << 64) | mag[i];
+            mag[i] = (uint64_t)(t / divisor);
+            remainder = t % divisor;
+        }
+    }
+};
+
+#endif // FIXED_POINT_H
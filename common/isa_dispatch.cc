@@ -0,0 +1,79 @@
+/**
+ * @file    isa_dispatch.cc
+ *
+ * @authors Matěj Konopík <xkonop03@stud.fit.vutbr.cz>
+ *
+ * @brief   Runtime selection of the instruction set used by the vectorized kernels
+ *
+ * @date    16 October 2026
+ **/
+
+#include "isa_dispatch.h"
+
+static bool isaSelected = false;
+static Isa isaCurrent = Isa::SSE42;
+
+bool isaSupported(Isa isa)
+{
+    __builtin_cpu_init();
+    switch (isa)
+    {
+    case Isa::AVX512:
+        return __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512dq") &&
+               __builtin_cpu_supports("avx512bw") && __builtin_cpu_supports("avx512vl");
+    case Isa::AVX2:
+        return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+    case Isa::SSE42:
+        return __builtin_cpu_supports("sse4.2");
+    }
+    return false;
+}
+
+Isa detectIsa()
+{
+    if (isaSupported(Isa::AVX512))
+        return Isa::AVX512;
+    if (isaSupported(Isa::AVX2))
+        return Isa::AVX2;
+    return Isa::SSE42;
+}
+
+bool parseIsa(const std::string &name, Isa &isa)
+{
+    if (name == "avx512")
+        isa = Isa::AVX512;
+    else if (name == "avx2")
+        isa = Isa::AVX2;
+    else if (name == "sse4.2" || name == "sse42")
+        isa = Isa::SSE42;
+    else
+        return false;
+    return true;
+}
+
+const char *isaName(Isa isa)
+{
+    switch (isa)
+    {
+    case Isa::AVX512:
+        return "avx512";
+    case Isa::AVX2:
+        return "avx2";
+    case Isa::SSE42:
+        return "sse4.2";
+    }
+    return "unknown";
+}
+
+void selectIsa(Isa isa)
+{
+    isaCurrent = isa;
+    isaSelected = true;
+}
+
+Isa selectedIsa()
+{
+    if (!isaSelected)
+        selectIsa(detectIsa());
+    return isaCurrent;
+}
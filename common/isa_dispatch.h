@@ -0,0 +1,88 @@
+/**
+ * @file    isa_dispatch.h
+ *
+ * @authors Matěj Konopík <xkonop03@stud.fit.vutbr.cz>
+ *
+ * @brief   Runtime selection of the instruction set used by the vectorized kernels
+ *
+ *          Kernel sources are compiled once per supported ISA (see CMakeLists.txt), each time into
+ *          its own namespace given by MANDEL_ISA_NS and with MANDEL_SIMD_BYTES set to the register
+ *          width. Calculators declare the kernels with ISA_DECLARE and pick one with ISA_DISPATCH.
+ *
+ * @date    16 October 2026
+ **/
+
+#ifndef ISA_DISPATCH_H
+#define ISA_DISPATCH_H
+
+#include <string>
+
+enum class Isa
+{
+    SSE42,
+    AVX2,
+    AVX512
+};
+
+/**
+ * @brief Checks (via cpuid) whether the CPU is able to run kernels compiled for the given ISA
+ */
+bool isaSupported(Isa isa);
+
+/**
+ * @brief Returns the widest ISA supported by the CPU
+ */
+Isa detectIsa();
+
+/**
+ * @brief Parses ISA name given on the command line [sse4.2, avx2, avx512]
+ *
+ * @return false if the name is unknown
+ */
+bool parseIsa(const std::string &name, Isa &isa);
+
+const char *isaName(Isa isa);
+
+/**
+ * @brief Overrides the ISA used by the calculators constructed afterwards
+ */
+void selectIsa(Isa isa);
+
+/**
+ * @brief ISA used by the calculators, detected on the first call unless selected explicitly
+ */
+Isa selectedIsa();
+
+// declares the same kernel(s) in the namespace of every compiled ISA
+#define ISA_DECLARE(...)                 \
+    namespace isa_sse42 { __VA_ARGS__ }  \
+    namespace isa_avx2 { __VA_ARGS__ }   \
+    namespace isa_avx512 { __VA_ARGS__ }
+
+// address of the kernel compiled for the given ISA
+#define ISA_DISPATCH(isa, ...)                       \
+    ((isa) == Isa::AVX512 ? &isa_avx512::__VA_ARGS__ \
+   : (isa) == Isa::AVX2   ? &isa_avx2::__VA_ARGS__   \
+                          : &isa_sse42::__VA_ARGS__)
+
+#ifdef MANDEL_ISA_NS
+namespace MANDEL_ISA_NS {
+/**
+ * @brief Number of elements of type T in one register of the ISA the current kernel source is compiled for
+ */
+template <typename T>
+constexpr int simdLen() { return MANDEL_SIMD_BYTES / sizeof(T); }
+
+/**
+ * @brief replacement where take is set, value otherwise, without a branch
+ *
+ * A select keeping the stored value is turned into a conditional store by the compiler, which SSE 4.2 cannot
+ * vectorize (it has no masked stores), the bitwise form is stored unconditionally.
+ */
+static inline int selectInt(bool take, int replacement, int value) {
+    return value ^ ((replacement ^ value) & -int(take));
+}
+}
+#endif
+
+#endif // ISA_DISPATCH_H
@@ -0,0 +1,170 @@
+/**
+ * @file    numa_placement.cc
+ *
+ * @authors Matěj Konopík <xkonop03@stud.fit.vutbr.cz>
+ *
+ * @brief   Thread pinning and memory placement over the NUMA nodes
+ *
+ * @date    16 October 2026
+ **/
+
+#include <algorithm>
+#include <cstdint>
+
+#include <sched.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
+#ifdef HAVE_LIBNUMA
+#include <numa.h>
+#include <numaif.h>
+#endif
+
+#include "numa_placement.h"
+
+static Placement placementCurrent = Placement::NONE;
+static std::vector<std::vector<int>> nodeCpus;   // CPUs of the process affinity mask per node
+static std::vector<int> cpuOrder;                // CPU of every thread index (modulo its size)
+
+bool parsePlacement(const std::string &name, Placement &placement)
+{
+    if (name == "none")
+        placement = Placement::NONE;
+    else if (name == "compact")
+        placement = Placement::COMPACT;
+    else if (name == "scatter")
+        placement = Placement::SCATTER;
+    else
+        return false;
+    return true;
+}
+
+const char *placementName(Placement placement)
+{
+    switch (placement)
+    {
+    case Placement::NONE:
+        return "none";
+    case Placement::COMPACT:
+        return "compact";
+    case Placement::SCATTER:
+        return "scatter";
+    }
+    return "unknown";
+}
+
+/**
+ * @brief Groups the CPUs the process may run on by their node
+ */
+static void readTopology()
+{
+    cpu_set_t allowed;
+    CPU_ZERO(&allowed);
+    if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0)
+        CPU_SET(0, &allowed);
+
+    nodeCpus.clear();
+#ifdef HAVE_LIBNUMA
+    const bool numa = numa_available() >= 0;
+#else
+    const bool numa = false;
+#endif
+    for (int cpu = 0; cpu < CPU_SETSIZE; cpu++)
+    {
+        if (!CPU_ISSET(cpu, &allowed))
+            continue;
+        int node = 0;
+#ifdef HAVE_LIBNUMA
+        if (numa)
+            node = std::max(numa_node_of_cpu(cpu), 0);
+#endif
+        if ((int) nodeCpus.size() <= node)
+            nodeCpus.resize(node + 1);
+        nodeCpus[node].push_back(cpu);
+    }
+    // nodes without allowed CPUs (memory only nodes, cpusets) do not get any thread
+    nodeCpus.erase(std::remove_if(nodeCpus.begin(), nodeCpus.end(),
+                                  [](const std::vector<int> &cpus) { return cpus.empty(); }),
+                   nodeCpus.end());
+    if (nodeCpus.empty())
+        nodeCpus.push_back({0});
+}
+
+void selectPlacement(Placement placement)
+{
+    placementCurrent = placement;
+    readTopology();
+
+    cpuOrder.clear();
+    if (placement == Placement::COMPACT)
+    {
+        for (const auto &cpus : nodeCpus)
+            cpuOrder.insert(cpuOrder.end(), cpus.begin(), cpus.end());
+    }
+    else if (placement == Placement::SCATTER)
+    {
+        size_t largest = 0;
+        for (const auto &cpus : nodeCpus)
+            largest = std::max(largest, cpus.size());
+        for (size_t i = 0; i < largest; i++)
+            for (const auto &cpus : nodeCpus)
+                if (i < cpus.size())
+                    cpuOrder.push_back(cpus[i]);
+    }
+}
+
+Placement selectedPlacement()
+{
+    return placementCurrent;
+}
+
+int numaNodes()
+{
+    if (nodeCpus.empty())
+        readTopology();
+    return nodeCpus.size();
+}
+
+bool pinThread(int thread)
+{
+    if (cpuOrder.empty())
+        return false;
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpuOrder[thread % cpuOrder.size()], &set);
+    return sched_setaffinity(0, sizeof(set), &set) == 0;
+}
+
+std::vector<long> pagesPerNode(const void *data, size_t bytes)
+{
+    const size_t page = sysconf(_SC_PAGESIZE);
+    const uintptr_t first = (uintptr_t) data / page * page;
+    const size_t count = ((uintptr_t) data + bytes - first + page - 1) / page;
+    std::vector<long> pages(std::max(numaNodes(), 1), 0);
+
+#ifdef HAVE_LIBNUMA
+    if (numa_available() >= 0)
+    {
+        // move_pages without target nodes only queries the node of every page
+        std::vector<void *> addresses(count);
+        std::vector<int> status(count);
+        for (size_t i = 0; i < count; i++)
+            addresses[i] = (void *) (first + i * page);
+        if (move_pages(0, count, addresses.data(), nullptr, status.data(), 0) == 0)
+        {
+            pages.assign(numa_max_node() + 1, 0);
+            for (auto node : status)
+                if (node >= 0)
+                    pages[node]++;
+            return pages;
+        }
+    }
+#endif
+
+    // single node fallback, count the resident pages
+    std::vector<unsigned char> resident(count);
+    if (mincore((void *) first, count * page, resident.data()) == 0)
+        for (auto flags : resident)
+            pages[0] += flags & 1;
+    return pages;
+}
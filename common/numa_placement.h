@@ -0,0 +1,61 @@
+/**
+ * @file    numa_placement.h
+ *
+ * @authors Matěj Konopík <xkonop03@stud.fit.vutbr.cz>
+ *
+ * @brief   Thread pinning and memory placement over the NUMA nodes
+ *
+ *          The topology is read through libnuma when the build found it (HAVE_LIBNUMA), otherwise
+ *          the machine is treated as a single node and the threads are pinned in the CPU order.
+ *          Pages are placed by first touch, the calculators write their matrix from the pinned
+ *          threads with the same schedule they calculate it with.
+ *
+ * @date    16 October 2026
+ **/
+
+#ifndef NUMA_PLACEMENT_H
+#define NUMA_PLACEMENT_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+enum class Placement
+{
+    NONE,       // threads are not pinned, the matrix is touched by the first thread writing it
+    COMPACT,    // fill the CPUs of one node before moving to the next one
+    SCATTER     // distribute the threads round-robin over the nodes
+};
+
+/**
+ * @brief Parses the placement name (none, compact, scatter)
+ * @return false for an unknown name
+ */
+bool parsePlacement(const std::string &name, Placement &placement);
+
+const char *placementName(Placement placement);
+
+/**
+ * @brief Sets the placement used by the calculators and reads the topology, has to be called before any pinning
+ */
+void selectPlacement(Placement placement);
+
+Placement selectedPlacement();
+
+/**
+ * @brief Number of NUMA nodes with a CPU the process may run on (1 without libnuma)
+ */
+int numaNodes();
+
+/**
+ * @brief Pins the calling thread to the CPU of the given thread index according to the selected placement
+ * @return false when the affinity could not be set
+ */
+bool pinThread(int thread);
+
+/**
+ * @brief Counts the pages of the buffer resident on every node, pages not touched yet are not counted
+ */
+std::vector<long> pagesPerNode(const void *data, size_t bytes);
+
+#endif
@@ -0,0 +1,106 @@
+/**
+ * @file    shared_matrix.cc
+ *
+ * @authors Matěj Konopík <xkonop03@stud.fit.vutbr.cz>
+ *
+ * @brief   Output matrix shared by forked worker processes, with an atomic band counter
+ *
+ * @date    16 October 2026
+ **/
+
+#include <cerrno>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <string>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
+#include "shared_matrix.h"
+
+#define SHARED_MATRIX_ALIGN 4096                // the matrix starts on its own page
+
+static_assert(ATOMIC_INT_LOCK_FREE == 2 && ATOMIC_LONG_LOCK_FREE == 2,
+              "The band counter has to be lock-free to be shared between processes");
+
+/**
+ * @brief Anonymous shared memory object of the given size
+ */
+static int createSharedFile(size_t bytes)
+{
+#ifdef MFD_CLOEXEC
+    int fd = memfd_create("mandelbrot", MFD_CLOEXEC);
+#else
+    int fd = -1;
+#endif
+    if (fd < 0)
+    {
+        const std::string name = "/mandelbrot." + std::to_string(getpid());
+        fd = shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+        if (fd >= 0)
+            shm_unlink(name.c_str());
+    }
+    if (fd < 0)
+        throw std::runtime_error(std::string("SharedMatrix: cannot create the shared memory: ") + strerror(errno));
+    if (ftruncate(fd, bytes) != 0)
+    {
+        const int error = errno;
+        close(fd);
+        throw std::runtime_error(std::string("SharedMatrix: cannot resize the shared memory: ") + strerror(error));
+    }
+    return fd;
+}
+
+SharedMatrix::SharedMatrix(int width, int height, int processes)
+{
+    const size_t header_bytes = (sizeof(Header) + processes * sizeof(int) + SHARED_MATRIX_ALIGN - 1)
+                                / SHARED_MATRIX_ALIGN * SHARED_MATRIX_ALIGN;
+    bytes = header_bytes + (size_t) width * height * sizeof(int);
+
+    const int fd = createSharedFile(bytes);
+    mapping = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    // the mapping keeps the memory alive
+    close(fd);
+    if (mapping == MAP_FAILED)
+        throw std::runtime_error(std::string("SharedMatrix: cannot map the shared memory: ") + strerror(errno));
+
+    // the new pages are zeroed, which is a valid state of both the counters
+    header = new (mapping) Header();
+    header->nextBand.store(0);
+    header->evaluatedCells.store(0);
+    band_counts = (int *) ((char *) mapping + sizeof(Header));
+    matrix = (int *) ((char *) mapping + header_bytes);
+}
+
+SharedMatrix::~SharedMatrix()
+{
+    munmap(mapping, bytes);
+}
+
+int *SharedMatrix::data()
+{
+    return matrix;
+}
+
+int SharedMatrix::claimBand()
+{
+    return header->nextBand.fetch_add(1, std::memory_order_relaxed);
+}
+
+void SharedMatrix::finishBand(int process, long evaluatedCells)
+{
+    band_counts[process]++;
+    header->evaluatedCells.fetch_add(evaluatedCells, std::memory_order_relaxed);
+}
+
+int SharedMatrix::bands(int process) const
+{
+    return band_counts[process];
+}
+
+long SharedMatrix::evaluatedCells() const
+{
+    return header->evaluatedCells.load();
+}
@@ -0,0 +1,64 @@
+/**
+ * @file    shared_matrix.h
+ *
+ * @authors Matěj Konopík <xkonop03@stud.fit.vutbr.cz>
+ *
+ * @brief   Output matrix shared by forked worker processes, with an atomic band counter
+ *
+ *          The mapping is backed by an anonymous memfd (a shm_open object unlinked right away where
+ *          memfd_create is missing) and mapped MAP_SHARED before the workers are forked, so every
+ *          worker writes directly into the matrix the parent saves.
+ *
+ * @date    16 October 2026
+ **/
+
+#ifndef SHARED_MATRIX_H
+#define SHARED_MATRIX_H
+
+#include <atomic>
+#include <cstddef>
+
+class SharedMatrix
+{
+public:
+    /**
+     * @param processes number of workers, each gets its own band counter
+     * @throws std::runtime_error when the shared mapping cannot be created
+     */
+    SharedMatrix(int width, int height, int processes);
+    ~SharedMatrix();
+
+    SharedMatrix(const SharedMatrix &) = delete;
+    SharedMatrix &operator=(const SharedMatrix &) = delete;
+
+    int *data();
+
+    /**
+     * @brief Claims the next band, safe to call from all the processes at once
+     * @return index of the band, bands are claimed in increasing order
+     */
+    int claimBand();
+
+    /**
+     * @brief Records a finished band of the given worker
+     */
+    void finishBand(int process, long evaluatedCells);
+
+    int bands(int process) const;
+    long evaluatedCells() const;
+
+private:
+    struct Header
+    {
+        std::atomic<int> nextBand;
+        std::atomic<long> evaluatedCells;
+    };
+
+    size_t bytes;
+    void *mapping;
+    Header *header;
+    int *band_counts;   // bands finished by every worker, each counter is written by its worker only
+    int *matrix;
+};
+
+#endif
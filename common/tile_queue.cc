@@ -0,0 +1,265 @@
+/**
+ * @file    tile_queue.cc
+ *
+ * @authors Matěj Konopík <xkonop03@stud.fit.vutbr.cz>
+ *
+ * @brief   Queue of tiles in a directory shared by independent processes, possibly on different nodes
+ *
+ * @date    16 October 2026
+ **/
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+#include "tile_queue.h"
+
+#define QUEUE_MANIFEST "queue"
+#define QUEUE_MAGIC "mandelbrot-queue"
+
+static std::runtime_error queueError(const std::string &message, const std::string &path)
+{
+    return std::runtime_error("TileQueue: " + message + " " + path + ": " + strerror(errno));
+}
+
+static bool fileExists(const std::string &path)
+{
+    struct stat st;
+    return stat(path.c_str(), &st) == 0;
+}
+
+/**
+ * @brief Writes the whole buffer into a new file, the data is on the disk when it returns
+ */
+static void writeFile(const std::string &path, const void *data, size_t bytes)
+{
+    const int fd = open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0)
+        throw queueError("cannot create", path);
+    for (size_t written = 0; written < bytes;)
+    {
+        const ssize_t count = write(fd, (const char *) data + written, bytes - written);
+        if (count < 0 && errno != EINTR)
+        {
+            close(fd);
+            throw queueError("cannot write", path);
+        }
+        written += count > 0 ? count : 0;
+    }
+    // other nodes must not see the tile renamed into place before its data
+    if (fsync(fd) != 0 || close(fd) != 0)
+        throw queueError("cannot write", path);
+}
+
+static std::string formatManifest(const QueueManifest &manifest)
+{
+    std::ostringstream text;
+    text << QUEUE_MAGIC << "\n"
+         << "width " << manifest.width << "\n"
+         << "height " << manifest.height << "\n"
+         << "rows " << manifest.rows << "\n"
+         << "tile_rows " << manifest.tileRows << "\n"
+         << "tiles " << manifest.tiles << "\n"
+         << "symmetric " << manifest.symmetric << "\n"
+         << "job " << manifest.job << "\n";
+    return text.str();
+}
+
+int QueueManifest::tileLines(int tile) const
+{
+    return std::min(tileRows, rows - tile * tileRows);
+}
+
+TileQueue::TileQueue(const std::string &dir, const QueueManifest &manifest, int leaseSeconds) :
+        dir(dir), layout(manifest), lease_seconds(leaseSeconds), next_tile(0), rescanned(false), claimed(0),
+        taken_over(0), lease_fd(-1), stopping(false)
+{
+    char host[256] = "localhost";
+    gethostname(host, sizeof(host) - 1);
+    owner = std::string(host) + "." + std::to_string(getpid());
+
+    if (mkdir(dir.c_str(), 0755) != 0 && errno != EEXIST)
+        throw queueError("cannot create the directory", dir);
+
+    // link fails when the manifest exists, the first process publishes a complete one
+    const std::string path = dir + "/" + QUEUE_MANIFEST;
+    const std::string temporary = path + "." + owner;
+    const std::string text = formatManifest(manifest);
+    writeFile(temporary, text.data(), text.size());
+    const bool created = link(temporary.c_str(), path.c_str()) == 0;
+    const int error = errno;
+    unlink(temporary.c_str());
+    if (!created)
+    {
+        errno = error;
+        if (error != EEXIST)
+            throw queueError("cannot create the manifest", path);
+        if (formatManifest(readManifest(dir)) != text)
+            throw std::runtime_error("TileQueue: " + dir + " holds the queue of a different job");
+    }
+    renewer = std::thread(&TileQueue::renewLeases, this);
+}
+
+TileQueue::~TileQueue()
+{
+    {
+        std::lock_guard<std::mutex> lock(lease_mutex);
+        stopping = true;
+    }
+    lease_wake.notify_one();
+    renewer.join();
+    if (lease_fd >= 0)
+        close(lease_fd);
+}
+
+void TileQueue::renewLeases()
+{
+    const std::chrono::milliseconds period(lease_seconds * 1000 / 4);
+    std::unique_lock<std::mutex> lock(lease_mutex);
+    while (!lease_wake.wait_for(lock, period, [this] { return stopping; }))
+    {
+        // the lease is renewed through its descriptor, a lease taken over by another process is not touched
+        if (lease_fd >= 0)
+            futimens(lease_fd, nullptr);
+    }
+}
+
+bool TileQueue::lease(int tile)
+{
+    const std::string path = dir + "/tile." + std::to_string(tile) + ".lease";
+    const std::string text = owner + "\n";
+    for (;;)
+    {
+        const int fd = open(path.c_str(), O_WRONLY | O_CREAT | O_EXCL, 0644);
+        if (fd >= 0)
+        {
+            if (write(fd, text.data(), text.size()) != (ssize_t) text.size())
+            {
+                close(fd);
+                throw queueError("cannot write the lease", path);
+            }
+            // the tile may have been finished since it was checked, its owner releases the lease after publishing it
+            if (fileExists(tilePath(dir, tile)))
+            {
+                close(fd);
+                unlink(path.c_str());
+                return false;
+            }
+            std::lock_guard<std::mutex> lock(lease_mutex);
+            lease_fd = fd;
+            return true;
+        }
+        if (errno != EEXIST)
+            throw queueError("cannot create the lease", path);
+
+        struct stat st;
+        if (stat(path.c_str(), &st) != 0)
+        {
+            if (errno == ENOENT)
+                continue;   // released in the meantime
+            throw queueError("cannot read the lease", path);
+        }
+        // compared in nanoseconds, the lease is renewed more often than every second
+        struct timespec now;
+        clock_gettime(CLOCK_REALTIME, &now);
+        if ((now.tv_sec - st.st_mtim.tv_sec) * 1000000000LL + (now.tv_nsec - st.st_mtim.tv_nsec)
+            < lease_seconds * 1000000000LL)
+            return false;
+
+        // only one of the processes finding the lease expired moves it away
+        const std::string stale = path + ".stale." + owner;
+        if (rename(path.c_str(), stale.c_str()) != 0)
+            return false;
+        unlink(stale.c_str());
+        taken_over++;
+    }
+}
+
+int TileQueue::claim()
+{
+    for (;;)
+    {
+        for (; next_tile < layout.tiles; next_tile++)
+        {
+            if (!fileExists(tilePath(dir, next_tile)) && lease(next_tile))
+            {
+                claimed++;
+                return next_tile++;
+            }
+        }
+        // leases passed over may have expired since, look at all the tiles once more before leaving
+        if (rescanned)
+            return -1;
+        rescanned = true;
+        next_tile = 0;
+    }
+}
+
+void TileQueue::finish(int tile, const int *data)
+{
+    const std::string path = tilePath(dir, tile);
+    const std::string temporary = path + "." + owner;
+    writeFile(temporary, data, (size_t) layout.tileLines(tile) * layout.width * sizeof(int));
+    if (rename(temporary.c_str(), path.c_str()) != 0)
+        throw queueError("cannot publish", path);
+
+    {
+        std::lock_guard<std::mutex> lock(lease_mutex);
+        close(lease_fd);
+        lease_fd = -1;
+    }
+    // the lease may have expired and been taken over by another process, whose lease must stay
+    const std::string lease = dir + "/tile." + std::to_string(tile) + ".lease";
+    std::string holder;
+    std::ifstream file(lease);
+    if (std::getline(file, holder) && holder == owner)
+        unlink(lease.c_str());
+}
+
+const QueueManifest &TileQueue::manifest() const
+{
+    return layout;
+}
+
+int TileQueue::claimedTiles() const
+{
+    return claimed;
+}
+
+int TileQueue::takenOverTiles() const
+{
+    return taken_over;
+}
+
+QueueManifest TileQueue::readManifest(const std::string &dir)
+{
+    const std::string path = dir + "/" + QUEUE_MANIFEST;
+    std::ifstream file(path);
+    if (!file)
+        throw queueError("cannot open the manifest", path);
+
+    QueueManifest manifest;
+    std::string magic, key[7];
+    file >> magic >> key[0] >> manifest.width >> key[1] >> manifest.height >> key[2] >> manifest.rows
+         >> key[3] >> manifest.tileRows >> key[4] >> manifest.tiles >> key[5] >> manifest.symmetric >> key[6];
+    std::getline(file >> std::ws, manifest.job);
+    if (!file || magic != QUEUE_MAGIC || key[0] != "width" || key[1] != "height" || key[2] != "rows" ||
+        key[3] != "tile_rows" || key[4] != "tiles" || key[5] != "symmetric" || key[6] != "job" ||
+        manifest.tileRows < 1 || manifest.tiles != (manifest.rows + manifest.tileRows - 1) / manifest.tileRows)
+        throw std::runtime_error("TileQueue: " + path + " is not a valid manifest");
+    return manifest;
+}
+
+std::string TileQueue::tilePath(const std::string &dir, int tile)
+{
+    return dir + "/tile." + std::to_string(tile) + ".raw";
+}
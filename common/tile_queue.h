@@ -0,0 +1,112 @@
+/**
+ * @file    tile_queue.h
+ *
+ * @authors Matěj Konopík <xkonop03@stud.fit.vutbr.cz>
+ *
+ * @brief   Queue of tiles in a directory shared by independent processes, possibly on different nodes
+ *
+ *          The directory holds the manifest of the job ("queue"), a lease file per claimed tile
+ *          ("tile.<i>.lease", created with O_CREAT | O_EXCL) and the raw lines of every finished tile
+ *          ("tile.<i>.raw", renamed into place once complete). A lease older than the lease time is
+ *          considered abandoned and can be taken over, the owner renews its lease while it calculates
+ *          the tile, so that only the leases of dead processes expire. Tiles are deterministic and published by
+ *          a rename, so a tile calculated twice after a race on a stale lease only costs time.
+ *          The lease expiry compares the file times with the local clock, the clocks of the nodes
+ *          have to agree to a fraction of the lease time.
+ *
+ * @date    16 October 2026
+ **/
+
+#ifndef TILE_QUEUE_H
+#define TILE_QUEUE_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <string>
+#include <thread>
+
+/**
+ * @brief Layout of the image split into the tiles of the queue
+ */
+struct QueueManifest
+{
+    int width;
+    int height;         // lines of the whole image
+    int rows;           // lines split into tiles, the first half of a symmetric image
+    int tileRows;       // lines of every tile but the last one
+    int tiles;
+    bool symmetric;     // the second half of the image mirrors the tiles
+    std::string job;    // description of the calculation, all the processes of the queue have to agree on it
+
+    /**
+     * @brief Lines of the given tile
+     */
+    int tileLines(int tile) const;
+};
+
+class TileQueue
+{
+public:
+    /**
+     * @brief Joins the queue in dir, the first process creates its manifest
+     * @param leaseSeconds age of a lease after which its tile is claimed again
+     * @throws std::runtime_error when the directory cannot be used or belongs to a different job
+     */
+    TileQueue(const std::string &dir, const QueueManifest &manifest, int leaseSeconds);
+    ~TileQueue();
+
+    /**
+     * @brief Claims a tile not finished and not leased by a live process, its lease is renewed until finish
+     * @return index of the tile, -1 when there is no work left for this process
+     */
+    int claim();
+
+    /**
+     * @brief Publishes the lines of a claimed tile and releases its lease if this process still holds it
+     * @throws std::runtime_error when the tile cannot be written
+     */
+    void finish(int tile, const int *data);
+
+    const QueueManifest &manifest() const;
+    int claimedTiles() const;
+    int takenOverTiles() const;
+
+    /**
+     * @brief Reads the manifest of the queue in dir
+     * @throws std::runtime_error when there is no valid manifest
+     */
+    static QueueManifest readManifest(const std::string &dir);
+
+    /**
+     * @brief Path of the raw lines of the finished tile
+     */
+    static std::string tilePath(const std::string &dir, int tile);
+
+private:
+    /**
+     * @brief Takes the lease of the tile, replaces an expired lease of another process
+     */
+    bool lease(int tile);
+
+    /**
+     * @brief Refreshes the time of the held lease every quarter of the lease time until the queue is destroyed
+     */
+    void renewLeases();
+
+    std::string dir;
+    QueueManifest layout;
+    int lease_seconds;
+    std::string owner;      // host.pid written into the leases and the temporary files
+    int next_tile;          // tiles before it were finished or leased when this process last looked
+    bool rescanned;         // the final pass over all the tiles for the expired leases was done
+    int claimed;
+    int taken_over;
+    int lease_fd;           // lease of the claimed tile kept open for the renewal, -1 when no tile is claimed
+    bool stopping;
+    std::mutex lease_mutex;
+    std::condition_variable lease_wake;
+    std::thread renewer;
+};
+
+#endif
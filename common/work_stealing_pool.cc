@@ -0,0 +1,274 @@
+/**
+ * @file    work_stealing_pool.cc
+ *
+ * @authors Matěj Konopík <xkonop03@stud.fit.vutbr.cz>
+ *
+ * @brief   Persistent pool of worker threads scheduling 2D blocks by work stealing
+ *
+ *          The deque follows Lê et al., Correct and Efficient Work-Stealing for Weak Memory Models
+ *          (PPoPP 2013), with a fixed circular buffer instead of a growing one.
+ *
+ * @date    16 October 2026
+ **/
+
+#include <chrono>
+#include <memory>
+
+#include "work_stealing_pool.h"
+
+#define POOL_STEAL_ATTEMPTS 4                   // failed steals per worker before yielding the core
+
+/**
+ * @brief Task is a rectangle [x_0, x_1) x [y_0, y_1) of blocks packed into one atomic word
+ */
+static inline uint64_t packTask(int x_0, int y_0, int x_1, int y_1)
+{
+    return (uint64_t) x_0 | (uint64_t) y_0 << 16 | (uint64_t) x_1 << 32 | (uint64_t) y_1 << 48;
+}
+
+static inline void unpackTask(uint64_t task, int &x_0, int &y_0, int &x_1, int &y_1)
+{
+    x_0 = task & 0xffff;
+    y_0 = task >> 16 & 0xffff;
+    x_1 = task >> 32 & 0xffff;
+    y_1 = task >> 48 & 0xffff;
+}
+
+WorkStealingPool::Deque::Deque() : top(0), bottom(0)
+{
+}
+
+bool WorkStealingPool::Deque::push(uint64_t task)
+{
+    const long b = bottom.load(std::memory_order_relaxed);
+    const long t = top.load(std::memory_order_acquire);
+    if (b - t >= POOL_DEQUE_CAPACITY)
+        return false;
+    tasks[b % POOL_DEQUE_CAPACITY].store(task, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    bottom.store(b + 1, std::memory_order_relaxed);
+    return true;
+}
+
+bool WorkStealingPool::Deque::pop(uint64_t &task)
+{
+    const long b = bottom.load(std::memory_order_relaxed) - 1;
+    bottom.store(b, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    long t = top.load(std::memory_order_relaxed);
+    if (t > b)
+    {
+        // empty
+        bottom.store(b + 1, std::memory_order_relaxed);
+        return false;
+    }
+    task = tasks[b % POOL_DEQUE_CAPACITY].load(std::memory_order_relaxed);
+    if (t == b)
+    {
+        // last task, race the thieves for it
+        const bool won = top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+        bottom.store(b + 1, std::memory_order_relaxed);
+        return won;
+    }
+    return true;
+}
+
+bool WorkStealingPool::Deque::steal(uint64_t &task)
+{
+    long t = top.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    const long b = bottom.load(std::memory_order_acquire);
+    if (t >= b)
+        return false;
+    task = tasks[t % POOL_DEQUE_CAPACITY].load(std::memory_order_relaxed);
+    return top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+}
+
+WorkStealingPool::WorkStealingPool(int workers) : generation(0), running(0), stopping(false), body(nullptr), remaining(0)
+{
+    for (int i = 0; i < workers; i++)
+    {
+        state.push_back(new Worker());
+        state[i]->seed = 2654435761u * (i + 1);
+    }
+    resetStats();
+    // worker 0 is the thread calling run()
+    for (int i = 1; i < workers; i++)
+        threads.emplace_back(&WorkStealingPool::loop, this, i);
+}
+
+WorkStealingPool::~WorkStealingPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    started.notify_all();
+    for (auto &thread : threads)
+        thread.join();
+    for (auto worker : state)
+        delete worker;
+}
+
+WorkStealingPool &WorkStealingPool::shared(int workers)
+{
+    static std::unique_ptr<WorkStealingPool> pool;
+    if (!pool || pool->workers() != workers)
+    {
+        pool.reset();
+        pool.reset(new WorkStealingPool(workers));
+    }
+    return *pool;
+}
+
+int WorkStealingPool::workers() const
+{
+    return state.size();
+}
+
+const WorkStealingPool::WorkerStats &WorkStealingPool::stats(int worker) const
+{
+    return state[worker]->stats;
+}
+
+void WorkStealingPool::resetStats()
+{
+    for (auto worker : state)
+        worker->stats = {0, 0, 0, 0.0};
+}
+
+void WorkStealingPool::run(int blocks_x, int blocks_y, const BlockFunction &body)
+{
+    if (blocks_x <= 0 || blocks_y <= 0)
+        return;
+
+    // the whole rectangle starts in the deque of the calling thread, the others steal its halves
+    remaining.store((long) blocks_x * blocks_y, std::memory_order_relaxed);
+    state[0]->deque.push(packTask(0, 0, blocks_x, blocks_y));
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        this->body = &body;
+        running = threads.size();
+        generation++;
+    }
+    started.notify_all();
+
+    work(0);
+
+    // the body has to outlive the job in all the workers
+    std::unique_lock<std::mutex> lock(mutex);
+    finished.wait(lock, [this] { return running == 0; });
+    this->body = nullptr;
+}
+
+void WorkStealingPool::loop(int worker)
+{
+    long seen = 0;
+    while (true)
+    {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            started.wait(lock, [&] { return stopping || generation != seen; });
+            if (stopping)
+                return;
+            seen = generation;
+        }
+
+        work(worker);
+
+        bool last;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            last = --running == 0;
+        }
+        if (last)
+            finished.notify_one();
+    }
+}
+
+void WorkStealingPool::work(int worker)
+{
+    Worker &self = *state[worker];
+    const int count = state.size();
+    uint64_t task;
+
+    while (remaining.load(std::memory_order_acquire) > 0)
+    {
+        if (self.deque.pop(task))
+        {
+            execute(task, worker);
+            continue;
+        }
+
+        // own deque is empty, steal from random victims until there is work or the job is done
+        auto idle_start = std::chrono::steady_clock::now();
+        bool found = false;
+        while (!found && remaining.load(std::memory_order_acquire) > 0)
+        {
+            for (int attempt = 0; attempt < POOL_STEAL_ATTEMPTS && !found; attempt++)
+            {
+                if (count < 2)
+                    break;
+                // xorshift32
+                self.seed ^= self.seed << 13;
+                self.seed ^= self.seed >> 17;
+                self.seed ^= self.seed << 5;
+                int victim = self.seed % (count - 1);
+                victim += victim >= worker;
+
+                if (state[victim]->deque.steal(task))
+                {
+                    self.stats.steals++;
+                    found = true;
+                }
+                else
+                {
+                    self.stats.failedSteals++;
+                }
+            }
+            if (!found)
+                std::this_thread::yield();
+        }
+        self.stats.idleTime += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - idle_start).count();
+
+        if (found)
+            execute(task, worker);
+    }
+}
+
+void WorkStealingPool::execute(uint64_t task, int worker)
+{
+    Worker &self = *state[worker];
+    int x_0, y_0, x_1, y_1;
+    unpackTask(task, x_0, y_0, x_1, y_1);
+
+    // keep the first half, offer the second one to the thieves
+    while (x_1 - x_0 > 1 || y_1 - y_0 > 1)
+    {
+        uint64_t half;
+        int x_split = x_1, y_split = y_1;
+        if (x_1 - x_0 >= y_1 - y_0)
+        {
+            x_split = (x_0 + x_1) / 2;
+            half = packTask(x_split, y_0, x_1, y_1);
+        }
+        else
+        {
+            y_split = (y_0 + y_1) / 2;
+            half = packTask(x_0, y_split, x_1, y_1);
+        }
+        if (!self.deque.push(half))
+        {
+            // deque full, process the second half right after the first one
+            execute(packTask(x_0, y_0, x_split, y_split), worker);
+            execute(half, worker);
+            return;
+        }
+        x_1 = x_split;
+        y_1 = y_split;
+    }
+
+    (*body)(x_0, y_0, worker);
+    self.stats.blocks++;
+    remaining.fetch_sub(1, std::memory_order_acq_rel);
+}
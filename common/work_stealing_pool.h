@@ -0,0 +1,120 @@
+/**
+ * @file    work_stealing_pool.h
+ *
+ * @authors Matěj Konopík <xkonop03@stud.fit.vutbr.cz>
+ *
+ * @brief   Persistent pool of worker threads scheduling 2D blocks by work stealing
+ *
+ *          A job is a rectangle of blocks (e.g. groups of tiles of a calculator). Every worker owns
+ *          a Chase-Lev deque: it splits the rectangle it holds along its longer side, pushes one half
+ *          to the bottom of its deque and continues with the other one until a single block is left,
+ *          which is passed to the job body. Idle workers steal the oldest, i.e. the largest, halves
+ *          from the top of the deques of the others. The thread calling run() is worker 0, the other
+ *          threads sleep between the jobs, so they are started once per pool only.
+ *
+ * @date    16 October 2026
+ **/
+
+#ifndef WORK_STEALING_POOL_H
+#define WORK_STEALING_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#define POOL_DEQUE_CAPACITY 256                 // tasks per worker deque, splitting needs about log2(blocks)
+#define POOL_CACHE_LINE 64                      // padding of the data written by different workers
+
+class WorkStealingPool
+{
+public:
+    /**
+     * @brief Scheduling counters of one worker since the last resetStats
+     */
+    struct WorkerStats
+    {
+        long blocks;        // blocks passed to the job body
+        long steals;        // tasks taken from the deques of the other workers
+        long failedSteals;  // steal attempts that found an empty deque or lost the race
+        double idleTime;    // time spent looking for work [ms]
+    };
+
+    /**
+     * @brief Job body, called once for every block with the index of the worker running it
+     */
+    typedef std::function<void(int block_x, int block_y, int worker)> BlockFunction;
+
+    /**
+     * @param workers number of workers including the calling thread
+     */
+    explicit WorkStealingPool(int workers);
+    ~WorkStealingPool();
+
+    WorkStealingPool(const WorkStealingPool &) = delete;
+    WorkStealingPool &operator=(const WorkStealingPool &) = delete;
+
+    /**
+     * @brief Process wide pool, created on the first use and recreated when the number of workers changes
+     */
+    static WorkStealingPool &shared(int workers);
+
+    /**
+     * @brief Calls body for every block of the blocks_x x blocks_y rectangle and waits for all of them
+     */
+    void run(int blocks_x, int blocks_y, const BlockFunction &body);
+
+    int workers() const;
+    const WorkerStats &stats(int worker) const;
+    void resetStats();
+
+private:
+    /**
+     * @brief Chase-Lev deque of tasks, the owner pushes and pops at the bottom, the thieves steal at the top
+     */
+    class Deque
+    {
+    public:
+        Deque();
+        bool push(uint64_t task);       // owner only, fails when the deque is full
+        bool pop(uint64_t &task);       // owner only
+        bool steal(uint64_t &task);     // any worker, fails when empty or when another worker won the race
+
+    private:
+        std::atomic<long> top;
+        char top_padding[POOL_CACHE_LINE - sizeof(std::atomic<long>)];
+        std::atomic<long> bottom;
+        char bottom_padding[POOL_CACHE_LINE - sizeof(std::atomic<long>)];
+        std::atomic<uint64_t> tasks[POOL_DEQUE_CAPACITY];
+    };
+
+    struct Worker
+    {
+        Deque deque;
+        WorkerStats stats;
+        uint32_t seed;      // state of the victim selection
+        char padding[POOL_CACHE_LINE];
+    };
+
+    void work(int worker);
+    void execute(uint64_t task, int worker);
+    void loop(int worker);
+
+    std::vector<Worker *> state;
+    std::vector<std::thread> threads;
+
+    std::mutex mutex;
+    std::condition_variable started;    // signals a new job (or the shutdown) to the sleeping workers
+    std::condition_variable finished;   // signals the end of the job to the calling thread
+    long generation;                    // number of the current job
+    int running;                        // background workers still inside the current job
+    bool stopping;
+
+    const BlockFunction *body;
+    std::atomic<long> remaining;        // blocks of the current job that were not processed yet
+};
+
+#endif
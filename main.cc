@@ -12,49 +12,355 @@
 #include <string>
 #include <vector>
 #include <algorithm>
+#include <cstdio>
+#include <cstdint>
+#include <sstream>
+#include <iomanip>
+
+#include <omp.h>
+#include <unistd.h>
+#include <sys/wait.h>
 
 #include "cxxopts.hpp"
 
 #include "cnpy.h"
 #include "vector_helpers.h"
+#include "isa_dispatch.h"
+#include "numa_placement.h"
+#include "shared_matrix.h"
+#include "tile_queue.h"
 
 #include "RefMandelCalculator.h"
 #include "LineMandelCalculator.h"
+#include "Line512MandelCalculator.h"
 #include "BatchMandelCalculator.h"
+#include "PerturbationMandelCalculator.h"
+#include "MixedMandelCalculator.h"
+#include "SubdivisionMandelCalculator.h"
+#include "BoundaryTraceMandelCalculator.h"
+#include "TiledMandelCalculator.h"
+#include "EscapeTimeCalculator.h"
 
 using namespace std;
 
+#define PROCS_BAND_ROWS 32 // lines of the bands the worker processes claim
+#define QUEUE_TILE_ROWS 64 // lines of the tiles of the --queue-dir queue
+
+/**
+ * @brief Distribution of one evaluation over processes or independent jobs
+ **/
+struct RenderMode
+{
+	int procs;	// forked worker processes sharing the matrix
+	int shard;	// band of the image calculated by this job, when shards > 0
+	int shards; // number of bands the image is split into, 0 calculates the whole image
+	std::string queueDir; // directory of the tile queue shared with other processes, empty without a queue
+	std::string job; // description of the calculation the processes of the queue agree on
+	int lease; // seconds after which a tile leased by another process is claimed again
+};
+
+/**
+ * @brief Counts of a calculator as int, the shards, the queue tiles and the shared matrix hold 32-bit counts
+ *
+ * main selects int32 storage for them, the narrow calculators instantiated for the other modes are widened.
+ *
+ * @param buffer holds the widened counts of a narrow matrix
+ **/
+static const int *widenCounts(const int *data, size_t, std::vector<int> &)
+{
+	return data;
+}
+
+template <typename E>
+const int *widenCounts(const E *data, size_t cells, std::vector<int> &buffer)
+{
+	buffer.assign(data, data + cells);
+	return buffer.data();
+}
+
+/**
+ * @brief Whether calculator T mirrors the image, asks a calculator restricted to a single line
+ **/
+template <typename T, typename... Args>
+bool isSymmetricCalculator(unsigned baseSize, unsigned iters, Args... args)
+{
+	BaseMandelCalculator::selectWindow(0, 1);
+	T calculator(baseSize, iters, args...);
+	BaseMandelCalculator::selectWindow(0, 0);
+	return calculator.isSymmetric();
+}
+
+/**
+ * @brief Evaluates calculator T in procs forked worker processes claiming bands of the image
+ *
+ * Every band is calculated by a calculator restricted to it (see BaseMandelCalculator::selectWindow)
+ * and copied into the shared matrix, which is saved by the parent directly. Only the first half of
+ * a symmetric image is split into bands, the workers mirror them.
+ **/
+template <typename T, typename... Args>
+void evaluateProcesses(unsigned baseSize, unsigned iters, const std::string &fileName, bool batchMode, bool classify, int procs, Args... args)
+{
+	const int width = BaseMandelCalculator::selectedViewport().width;
+	const int height = BaseMandelCalculator::selectedViewport().height;
+
+	// calculator of the first band describes the evaluation and tells whether the image is symmetric
+	BaseMandelCalculator::selectWindow(0, std::min(PROCS_BAND_ROWS, height));
+	bool symmetric;
+	{
+		T calculator(baseSize, iters, args...);
+		calculator.info(std::cout, batchMode);
+		symmetric = calculator.isSymmetric();
+	}
+	const int rows = symmetric ? (height + 1) / 2 : height;
+	const int bands = (rows + PROCS_BAND_ROWS - 1) / PROCS_BAND_ROWS;
+
+	SharedMatrix *matrix;
+	try
+	{
+		matrix = new SharedMatrix(width, height, procs);
+	}
+	catch (const std::runtime_error &e)
+	{
+		std::cerr << e.what() << std::endl;
+		std::exit(1);
+	}
+	// the workers must not inherit the buffered output
+	std::cout.flush();
+
+	auto startTime = PerfClock_t::now();
+	std::vector<pid_t> workers;
+	for (int process = 0; process < procs; process++)
+	{
+		const pid_t pid = fork();
+		if (pid < 0)
+		{
+			std::cerr << "Cannot fork worker process " << process << std::endl;
+			std::exit(1);
+		}
+		if (pid == 0)
+		{
+			for (int band = matrix->claimBand(); band < bands; band = matrix->claimBand())
+			{
+				const int firstRow = band * PROCS_BAND_ROWS;
+				const int bandRows = std::min(PROCS_BAND_ROWS, rows - firstRow);
+				BaseMandelCalculator::selectWindow(firstRow, bandRows);
+				T calculator(baseSize, iters, args...);
+				calculator.setClassifier(classify);
+				const auto *data = calculator.calculateMandelbrot();
+
+				int *shared = matrix->data();
+				std::copy(data, data + (size_t)bandRows * width, shared + (size_t)firstRow * width);
+				for (int y = firstRow; symmetric && y < firstRow + bandRows; y++)
+					std::copy(shared + (size_t)y * width, shared + (size_t)(y + 1) * width, shared + (size_t)(height - y - 1) * width);
+				matrix->finishBand(process, calculator.evaluatedCells());
+			}
+			// skip the destructors and the atexit handlers of the parent
+			_exit(0);
+		}
+		workers.push_back(pid);
+	}
+
+	bool failed = false;
+	for (auto pid : workers)
+	{
+		int status;
+		failed |= waitpid(pid, &status, 0) != pid || !WIFEXITED(status) || WEXITSTATUS(status) != 0;
+	}
+	auto elapsedTime = PerfClockDurationMs(PerfClock_t::now() - startTime).count();
+	if (failed)
+	{
+		std::cerr << "A worker process failed" << std::endl;
+		std::exit(1);
+	}
+
+	if (batchMode)
+		std::cout << elapsedTime << ";" << matrix->evaluatedCells() << std::endl;
+	else
+	{
+		std::cout << "Elapsed Time:      " << elapsedTime << " ms" << std::endl;
+		std::cout << "Worker bands:      ";
+		for (int process = 0; process < procs; process++)
+			std::cout << (process ? ", " : "") << matrix->bands(process);
+		std::cout << " (" << bands << " bands of " << PROCS_BAND_ROWS << " lines)" << std::endl;
+	}
+
+	if (fileName.length() > 0)
+		cnpy::npz_save(fileName, "d", matrix->data(), {(size_t)height, (size_t)width}, "wb");
+	delete matrix;
+	BaseMandelCalculator::selectWindow(0, 0);
+}
+
+/**
+ * @brief Calculates the tiles of the queue in mode.queueDir until there is no work left
+ *
+ * Any number of such processes, on any nodes sharing the directory, calculate one image together.
+ * Every tile is calculated by a calculator restricted to its lines, only the first half of a symmetric
+ * image is split into tiles. The tiles are assembled by mandelbrot-merge --queue-dir.
+ **/
+template <typename T, typename... Args>
+void evaluateQueue(unsigned baseSize, unsigned iters, bool batchMode, bool classify, const RenderMode &mode, Args... args)
+{
+	const int width = BaseMandelCalculator::selectedViewport().width;
+	const int height = BaseMandelCalculator::selectedViewport().height;
+
+	BaseMandelCalculator::selectWindow(0, std::min(QUEUE_TILE_ROWS, height));
+	bool symmetric;
+	{
+		T calculator(baseSize, iters, args...);
+		calculator.info(std::cout, batchMode);
+		symmetric = calculator.isSymmetric();
+	}
+	const int rows = symmetric ? (height + 1) / 2 : height;
+	const QueueManifest manifest = {width, height, rows, QUEUE_TILE_ROWS, (rows + QUEUE_TILE_ROWS - 1) / QUEUE_TILE_ROWS, symmetric, mode.job};
+
+	long evaluatedCells = 0;
+	auto startTime = PerfClock_t::now();
+	try
+	{
+		TileQueue queue(mode.queueDir, manifest, mode.lease);
+		for (int tile = queue.claim(); tile >= 0; tile = queue.claim())
+		{
+			BaseMandelCalculator::selectWindow(tile * QUEUE_TILE_ROWS, manifest.tileLines(tile));
+			T calculator(baseSize, iters, args...);
+			calculator.setClassifier(classify);
+			std::vector<int> counts;
+			queue.finish(tile, widenCounts(calculator.calculateMandelbrot(), (size_t)calculator.height * calculator.width, counts));
+			evaluatedCells += calculator.evaluatedCells();
+		}
+		auto elapsedTime = PerfClockDurationMs(PerfClock_t::now() - startTime).count();
+
+		if (batchMode)
+			std::cout << elapsedTime << ";" << evaluatedCells << std::endl;
+		else
+		{
+			std::cout << "Elapsed Time:      " << elapsedTime << " ms" << std::endl;
+			std::cout << "Queue tiles:       " << queue.claimedTiles() << " of " << manifest.tiles << " (" << queue.takenOverTiles()
+					  << " expired leases taken over, " << QUEUE_TILE_ROWS << " lines each)" << std::endl;
+		}
+	}
+	catch (const std::runtime_error &e)
+	{
+		std::cerr << e.what() << std::endl;
+		std::exit(1);
+	}
+	BaseMandelCalculator::selectWindow(0, 0);
+}
+
 /**
  * @brief Creates mandelbrot calculator object (template T), evaluates the
  *        speed, and prints output
  **/
-template <typename T>
-void evaluateCalculator(unsigned baseSize, unsigned iters, const std::string &fileName, bool batchMode)
+template <typename T, typename... Args>
+void evaluateCalculator(unsigned baseSize, unsigned iters, const std::string &fileName, bool batchMode, bool classify, const RenderMode &mode, Args... args)
 {
-	T calculator(baseSize, iters);
+	if (mode.procs > 1)
+	{
+		evaluateProcesses<T>(baseSize, iters, fileName, batchMode, classify, mode.procs, args...);
+		return;
+	}
+	if (mode.queueDir.length() > 0)
+	{
+		evaluateQueue<T>(baseSize, iters, batchMode, classify, mode, args...);
+		return;
+	}
+
+	// the shards split the first half of a symmetric image only, mandelbrot-merge mirrors it
+	int firstRow = 0, rows = 0;
+	bool mirrored = false;
+	const int height = BaseMandelCalculator::selectedViewport().height;
+	if (mode.shards > 0)
+	{
+		mirrored = isSymmetricCalculator<T>(baseSize, iters, args...);
+		const int shardedRows = mirrored ? (height + 1) / 2 : height;
+		firstRow = (long)shardedRows * mode.shard / mode.shards;
+		rows = (long)shardedRows * (mode.shard + 1) / mode.shards - firstRow;
+		BaseMandelCalculator::selectWindow(firstRow, rows);
+	}
+
+	T calculator(baseSize, iters, args...);
+	calculator.setClassifier(classify);
+	BaseMandelCalculator::selectWindow(0, 0);
 
 	calculator.info(std::cout, batchMode);
+	if (mode.shards > 0 && !batchMode)
+	{
+		std::cout << "Shard:             " << mode.shard << "/" << mode.shards << " (lines " << firstRow << " to " << firstRow + rows - 1 << ")" << std::endl;
+		if (mirrored)
+			std::cout << "Merge:             mandelbrot-merge --mirror --height " << height << std::endl;
+	}
 
 	auto startTime = PerfClock_t::now();
 	auto data = calculator.calculateMandelbrot();
 	auto elapsedTime = PerfClockDurationMs(PerfClock_t::now() - startTime).count();
 
 	if (batchMode)
-		std::cout << elapsedTime << std::endl;
+		std::cout << elapsedTime << ";" << calculator.evaluatedCells() << std::endl;
 	else
 	{
 		std::cout << "Elapsed Time:      " << elapsedTime << " ms" << std::endl;
 	}
+	calculator.report(std::cout, batchMode);
 
 	if (fileName.length() > 0)
 	{
 		if(data == NULL)
 			std::cerr << "No data returned, skipping saving!" << std::endl;
+		else if (mode.shards > 0)
+		{
+			std::vector<int> counts;
+			cnpy::npy_save(fileName, widenCounts(data, (size_t)calculator.height * calculator.width, counts),
+						   {(size_t)calculator.height, (size_t)calculator.width}, "w");
+		}
 		else
+		{
 			cnpy::npz_save(fileName, "d", data, {(size_t)calculator.height, (size_t)calculator.width}, "wb");
+			// the smooth counts are the second array of the same archive
+			if (calculator.smoothData() != nullptr)
+				cnpy::npz_save(fileName, "s", calculator.smoothData(), {(size_t)calculator.height, (size_t)calculator.width}, "a");
+		}
 	}
 }
 
+/**
+ * @brief Evaluates calculator templated on the floating point type selected by precision
+ **/
+template <template <typename> class T, typename... Args>
+void evaluatePrecisionCalculator(const std::string &precision, unsigned baseSize, unsigned iters, const std::string &fileName, bool batchMode, bool classify, const RenderMode &mode, Args... args)
+{
+	if (precision == "double")
+		evaluateCalculator<T<double>>(baseSize, iters, fileName, batchMode, classify, mode, args...);
+	else
+		evaluateCalculator<T<float>>(baseSize, iters, fileName, batchMode, classify, mode, args...);
+}
+
+/**
+ * @brief Evaluates calculator templated on the floating point type selected by precision and on the element
+ *        type of the counts E
+ **/
+template <template <typename, typename> class T, typename E, typename... Args>
+void evaluatePrecisionStorageCalculator(const std::string &precision, unsigned baseSize, unsigned iters, const std::string &fileName, bool batchMode, bool classify, const RenderMode &mode, Args... args)
+{
+	if (precision == "double")
+		evaluateCalculator<T<double, E>>(baseSize, iters, fileName, batchMode, classify, mode, args...);
+	else
+		evaluateCalculator<T<float, E>>(baseSize, iters, fileName, batchMode, classify, mode, args...);
+}
+
+/**
+ * @brief Evaluates calculator templated on the floating point type selected by precision and on the element
+ *        type of the counts selected by storage
+ **/
+template <template <typename, typename> class T, typename... Args>
+void evaluateStorageCalculator(const std::string &precision, const std::string &storage, unsigned baseSize, unsigned iters, const std::string &fileName, bool batchMode, bool classify, const RenderMode &mode, Args... args)
+{
+	if (storage == "uint8")
+		evaluatePrecisionStorageCalculator<T, uint8_t>(precision, baseSize, iters, fileName, batchMode, classify, mode, args...);
+	else if (storage == "uint16")
+		evaluatePrecisionStorageCalculator<T, uint16_t>(precision, baseSize, iters, fileName, batchMode, classify, mode, args...);
+	else
+		evaluatePrecisionStorageCalculator<T, int>(precision, baseSize, iters, fileName, batchMode, classify, mode, args...);
+}
+
 int main(int argc, char *argv[])
 {
 
@@ -64,7 +370,33 @@ int main(int argc, char *argv[])
 		("o,output", "Output numpy file", cxxopts::value<std::string>()->default_value(""))
 		("s,size", "Base matrix size", cxxopts::value<unsigned>()->default_value("2048"))
 		("i,iters", "Number of iterations", cxxopts::value<unsigned>()->default_value("100"))
-		("c,calculator", "Calculator name [ref, batch, line]", cxxopts::value<std::string>()->default_value("ref"))
+		("c,calculator", "Calculator name [ref, batch, line, line512, mixed, perturbation, subdivision, trace, tiled, multibrot2, multibrot3, multibrot4, julia, julia3, julia4, burningship]", cxxopts::value<std::string>()->default_value("ref"))
+		("center-re", "Real part of the view center, 0 for the Julia sets", cxxopts::value<std::string>()->default_value("-0.5"))
+		("center-im", "Imaginary part of the view center", cxxopts::value<std::string>()->default_value("0"))
+		("zoom", "Magnification of the default view (3 x 3 around -0.5) around the view center", cxxopts::value<double>()->default_value("1"))
+		("width", "Width of the image, 0 for 3 x base size", cxxopts::value<int>()->default_value("0"))
+		("height", "Height of the image, 0 for 2 x base size", cxxopts::value<int>()->default_value("0"))
+		("julia-re", "Real part of the constant of the Julia sets", cxxopts::value<double>()->default_value("-0.8"))
+		("julia-im", "Imaginary part of the constant of the Julia sets", cxxopts::value<double>()->default_value("0.156"))
+		("series", "Skip iterations using series approximation in the perturbation calculator")
+		("precision", "Floating point type of the line, batch, tiled, perturbation, subdivision, trace and escape-time calculators [float, double]", cxxopts::value<std::string>()->default_value("float"))
+		("storage", "Element type of the iteration counts of the line, batch, tiled and escape-time calculators [auto, uint8, uint16, int32], auto picks the narrowest one holding the limit", cxxopts::value<std::string>()->default_value("auto"))
+		("classify", "Resolve the main cardioid, period-2 bulb and |c| > 2 analytically before iterating")
+		("periodicity", "Retire the cells with a periodic orbit early in the line and batch calculators")
+		("smooth", "Save the smooth iteration counts of the line calculator as a second float32 array (s) of the output")
+		("compact", "Iterate over the compacted still active cells only in the line calculator")
+		("refill", "Refill the lanes of the batch calculator with the next pending cell as soon as their cell is done")
+		("unroll", "Iterations between two escape checks of the tiled calculator [0, 4, 8, 16], 0 checks every iteration", cxxopts::value<int>()->default_value("0"))
+		("interleave", "Numbers of interleaved streams of the line and batch kernels [1-4], a list runs one evaluation per number", cxxopts::value<std::vector<int>>()->default_value("1"))
+		("threads", "Number of threads of the line, batch, tiled and escape-time calculators", cxxopts::value<int>()->default_value("1"))
+		("schedule", "OpenMP schedule of the lines of the line and batch calculators [dynamic, guided, static]", cxxopts::value<std::string>()->default_value("dynamic"))
+		("partition", "Distribution of the lines of the line and batch calculators over the threads [lines, cost], cost gives every thread one band of equal predicted cost", cxxopts::value<std::string>()->default_value("lines"))
+		("procs", "Number of forked worker processes sharing the output matrix, any calculator", cxxopts::value<int>()->default_value("1"))
+		("shard", "Calculate only band i of N of the image into a .npy file [i/N], see mandelbrot-merge", cxxopts::value<std::string>()->default_value(""))
+		("queue-dir", "Claim tiles of the image from a queue in a directory shared with other processes until none is left, see mandelbrot-merge --queue-dir", cxxopts::value<std::string>()->default_value(""))
+		("lease", "Seconds after which a tile of the queue claimed by another process is claimed again", cxxopts::value<int>()->default_value("300"))
+		("numa", "Thread pinning and first-touch placement of the line and batch calculators [none, compact, scatter], requires --schedule static", cxxopts::value<std::string>()->default_value("none"))
+		("isa", "Instruction set of the vectorized kernels [auto, sse4.2, avx2, avx512]", cxxopts::value<std::string>()->default_value("auto"))
 		("batch", "Run in silent/batch mode")
 		("h,help", "Print help");
 
@@ -82,18 +414,346 @@ int main(int argc, char *argv[])
 			std::exit(0);
 		}
 
+		const std::string isa = args["isa"].as<std::string>();
+		if (isa != "auto")
+		{
+			Isa selected;
+			if (!parseIsa(isa, selected))
+			{
+				std::cerr << "Unknown instruction set (" << isa << ")" << std::endl;
+				std::exit(1);
+			}
+			if (!isaSupported(selected))
+			{
+				std::cerr << "Instruction set " << isaName(selected) << " is not supported by this CPU" << std::endl;
+				std::exit(1);
+			}
+			selectIsa(selected);
+		}
+
+		const std::string precision = args["precision"].as<std::string>();
+		if (precision != "float" && precision != "double")
+		{
+			std::cerr << "Unknown precision (" << precision << ")" << std::endl;
+			std::exit(1);
+		}
+
 		const std::string calculator = args["calculator"].as<std::string>();
+		// calculators of the generic escape-time engine
+		const bool escapeTime = calculator == "multibrot2" || calculator == "multibrot3" || calculator == "multibrot4" ||
+								calculator == "julia" || calculator == "julia3" || calculator == "julia4" || calculator == "burningship";
+		const bool julia = calculator == "julia" || calculator == "julia3" || calculator == "julia4";
+		if (precision != "float" && calculator != "line" && calculator != "batch" && calculator != "tiled" && calculator != "perturbation" && calculator != "subdivision" && calculator != "trace" && !escapeTime)
+		{
+			std::cerr << "Calculator " << calculator << " supports float precision only" << std::endl;
+			std::exit(1);
+		}
+
+		const unsigned baseSize = args["size"].as<unsigned>();
+		const unsigned iters = args["iters"].as<unsigned>();
+
+		// the counts are in [0, limit]
+		std::string storage = args["storage"].as<std::string>();
+		const bool narrowStorage = calculator == "line" || calculator == "batch" || calculator == "tiled" || escapeTime;
+		if (storage == "auto")
+			storage = !narrowStorage ? "int32" : iters <= UINT8_MAX ? "uint8" : iters <= UINT16_MAX ? "uint16" : "int32";
+		if (storage != "uint8" && storage != "uint16" && storage != "int32")
+		{
+			std::cerr << "Unknown storage (" << storage << ")" << std::endl;
+			std::exit(1);
+		}
+		if (storage != "int32" && !narrowStorage)
+		{
+			std::cerr << "Calculator " << calculator << " stores int32 counts only" << std::endl;
+			std::exit(1);
+		}
+		if ((storage == "uint8" && iters > UINT8_MAX) || (storage == "uint16" && iters > UINT16_MAX))
+		{
+			std::cerr << "Storage " << storage << " cannot hold the iteration limit (" << iters << ")" << std::endl;
+			std::exit(1);
+		}
+		const std::string output = args["output"].as<std::string>();
+		const bool batchMode = args.count("batch");
+
+		// the Julia sets are centered on the origin, not on the Mandelbrot set
+		Viewport view = {julia && !args.count("center-re") ? "0" : args["center-re"].as<std::string>(), args["center-im"].as<std::string>(), args["zoom"].as<double>(),
+						 args["width"].as<int>(), args["height"].as<int>()};
+		try
+		{
+			std::stod(view.centerRe);
+			std::stod(view.centerIm);
+		}
+		catch (const std::exception &e)
+		{
+			std::cerr << "Invalid view center (" << view.centerRe << " " << view.centerIm << ")" << std::endl;
+			std::exit(1);
+		}
+		if (!(view.zoom > 0.0))
+		{
+			std::cerr << "Invalid zoom (" << view.zoom << ")" << std::endl;
+			std::exit(1);
+		}
+		view.width = view.width ? view.width : 3 * baseSize;
+		view.height = view.height ? view.height : 2 * baseSize;
+		if (view.width < 2 || view.height < 2)
+		{
+			std::cerr << "Invalid image size (" << view.width << "x" << view.height << ")" << std::endl;
+			std::exit(1);
+		}
+		BaseMandelCalculator::selectViewport(view);
+		const double juliaRe = args["julia-re"].as<double>();
+		const double juliaIm = args["julia-im"].as<double>();
+		// the cells escape once |z| > 2, which is only final when |c| <= 2
+		if (!(juliaRe * juliaRe + juliaIm * juliaIm <= 4.0))
+		{
+			std::cerr << "Invalid Julia constant (" << juliaRe << " " << juliaIm << "), expected |c| <= 2" << std::endl;
+			std::exit(1);
+		}
+		const bool classify = args.count("classify");
+		if (classify && (calculator == "ref" || calculator == "perturbation" || (escapeTime && calculator != "multibrot2")))
+		{
+			std::cerr << "Calculator " << calculator << " does not support the classifier" << std::endl;
+			std::exit(1);
+		}
+		const bool periodicity = args.count("periodicity");
+		if (periodicity && calculator != "line" && calculator != "batch")
+		{
+			std::cerr << "Calculator " << calculator << " does not support the periodicity check" << std::endl;
+			std::exit(1);
+		}
+		const bool smooth = args.count("smooth");
+		if (smooth && (calculator != "line" || periodicity))
+		{
+			std::cerr << "Smooth iteration counts are supported by the line calculator without the periodicity check only" << std::endl;
+			std::exit(1);
+		}
+		const bool compact = args.count("compact");
+		if (compact && (calculator != "line" || periodicity || smooth))
+		{
+			std::cerr << "Stream compaction is supported by the line calculator without the periodicity check and smooth counts only" << std::endl;
+			std::exit(1);
+		}
+		const int unroll = args["unroll"].as<int>();
+		if (unroll != 0 && unroll != 4 && unroll != 8 && unroll != 16)
+		{
+			std::cerr << "Unsupported unroll factor (" << unroll << ")" << std::endl;
+			std::exit(1);
+		}
+		if (unroll != 0 && calculator != "tiled")
+		{
+			std::cerr << "Calculator " << calculator << " does not support unrolling" << std::endl;
+			std::exit(1);
+		}
+		const std::vector<int> interleave = args["interleave"].as<std::vector<int>>();
+		for (auto streams : interleave)
+		{
+			if (streams < 1 || streams > MAX_STREAMS)
+			{
+				std::cerr << "Unsupported number of interleaved streams (" << streams << ")" << std::endl;
+				std::exit(1);
+			}
+			if (streams != 1 && ((calculator != "line" && calculator != "batch") || periodicity || compact || smooth))
+			{
+				std::cerr << "Interleaving is supported by the plain line and batch calculators only" << std::endl;
+				std::exit(1);
+			}
+		}
+		const int threads = args["threads"].as<int>();
+		if (threads < 1)
+		{
+			std::cerr << "Invalid number of threads (" << threads << ")" << std::endl;
+			std::exit(1);
+		}
+		if (threads > 1 && calculator != "line" && calculator != "batch" && calculator != "tiled" && !escapeTime)
+		{
+			std::cerr << "Calculator " << calculator << " supports a single thread only" << std::endl;
+			std::exit(1);
+		}
+		const int procs = args["procs"].as<int>();
+		if (procs < 1)
+		{
+			std::cerr << "Invalid number of processes (" << procs << ")" << std::endl;
+			std::exit(1);
+		}
+		RenderMode mode = {procs, 0, 0, args["queue-dir"].as<std::string>(), "", args["lease"].as<int>()};
+		const std::string shard = args["shard"].as<std::string>();
+		if (shard.length() > 0)
+		{
+			char separator = 0;
+			if (sscanf(shard.c_str(), "%d%c%d", &mode.shard, &separator, &mode.shards) != 3 || separator != '/' ||
+				mode.shards < 1 || mode.shard < 0 || mode.shard >= mode.shards || mode.shards > view.height / 2)
+			{
+				std::cerr << "Invalid shard (" << shard << "), expected i/N with 0 <= i < N <= half of the height" << std::endl;
+				std::exit(1);
+			}
+			if (procs > 1)
+			{
+				std::cerr << "Shards cannot be combined with worker processes" << std::endl;
+				std::exit(1);
+			}
+			if (output.length() < 4 || output.compare(output.length() - 4, 4, ".npy") != 0)
+			{
+				std::cerr << "Shards are saved as .npy files, the output has to end with .npy" << std::endl;
+				std::exit(1);
+			}
+		}
+		if (mode.queueDir.length() > 0)
+		{
+			if (procs > 1 || mode.shards > 0)
+			{
+				std::cerr << "The queue cannot be combined with worker processes or shards" << std::endl;
+				std::exit(1);
+			}
+			if (output.length() > 0)
+			{
+				std::cerr << "The tiles of the queue are saved into its directory, assemble them by mandelbrot-merge --queue-dir" << std::endl;
+				std::exit(1);
+			}
+			if (mode.lease < 1)
+			{
+				std::cerr << "Invalid lease time (" << mode.lease << ")" << std::endl;
+				std::exit(1);
+			}
+			// everything the image depends on, a process started with different options must not join the queue
+			std::ostringstream job;
+			job << calculator << " " << precision << " -s " << baseSize << " -i " << iters << " --center-re " << view.centerRe
+				<< " --center-im " << view.centerIm << " --zoom " << std::setprecision(17) << view.zoom;
+			if (julia)
+				job << " --julia-re " << juliaRe << " --julia-im " << juliaIm;
+			mode.job = job.str();
+		}
+		// the shards, the queue tiles and the shared matrix of the worker processes hold int32 counts
+		if (procs > 1 || mode.shards > 0 || mode.queueDir.length() > 0)
+		{
+			if (storage != "int32" && args["storage"].as<std::string>() != "auto")
+			{
+				std::cerr << "Worker processes, shards and the queue store int32 counts only" << std::endl;
+				std::exit(1);
+			}
+			storage = "int32";
+		}
+		if (smooth && (procs > 1 || mode.shards > 0 || mode.queueDir.length() > 0))
+		{
+			std::cerr << "Smooth iteration counts are saved by a single process only" << std::endl;
+			std::exit(1);
+		}
+		const std::string schedule = args["schedule"].as<std::string>();
+		if (schedule != "dynamic" && schedule != "guided" && schedule != "static")
+		{
+			std::cerr << "Unknown schedule (" << schedule << ")" << std::endl;
+			std::exit(1);
+		}
+		omp_set_num_threads(threads);
+		if (schedule == "static")
+			omp_set_schedule(omp_sched_static, 0);
+		else
+			omp_set_schedule(schedule == "guided" ? omp_sched_guided : omp_sched_dynamic, 1);
+
+		Placement placement;
+		if (!parsePlacement(args["numa"].as<std::string>(), placement))
+		{
+			std::cerr << "Unknown placement (" << args["numa"].as<std::string>() << ")" << std::endl;
+			std::exit(1);
+		}
+		if (placement != Placement::NONE && calculator != "line" && calculator != "batch")
+		{
+			std::cerr << "NUMA placement is supported by the line and batch calculators only" << std::endl;
+			std::exit(1);
+		}
+		selectPlacement(placement);
+
+		const std::string partition = args["partition"].as<std::string>();
+		if (partition != "lines" && partition != "cost")
+		{
+			std::cerr << "Unknown partition (" << partition << ")" << std::endl;
+			std::exit(1);
+		}
+		const bool costPartition = partition == "cost";
+		if (costPartition && calculator != "line" && calculator != "batch")
+		{
+			std::cerr << "Cost partition is supported by the line and batch calculators only" << std::endl;
+			std::exit(1);
+		}
+		// the matrix is touched line by line with the schedule of the calculation, the pages end up on the node
+		// of the thread calculating them only when the lines are statically assigned to the threads
+		if (placement != Placement::NONE && (schedule != "static" || costPartition))
+		{
+			std::cerr << "NUMA placement requires --schedule static and the lines partition" << std::endl;
+			std::exit(1);
+		}
+
+		const bool refill = args.count("refill");
+		if (refill && (calculator != "batch" || periodicity || interleave != std::vector<int>{1}))
+		{
+			std::cerr << "Lane refill is supported by the batch calculator without the periodicity check and interleaving only" << std::endl;
+			std::exit(1);
+		}
+
 		if (calculator == "ref")
 		{
-			evaluateCalculator<RefMandelCalculator>(args["size"].as<unsigned>(), args["iters"].as<unsigned>(), args["output"].as<std::string>(), args.count("batch"));
+			evaluateCalculator<RefMandelCalculator>(baseSize, iters, output, batchMode, classify, mode);
 		}
 		else if (calculator == "line")
 		{
-			evaluateCalculator<LineMandelCalculator>(args["size"].as<unsigned>(), args["iters"].as<unsigned>(), args["output"].as<std::string>(), args.count("batch"));
+			for (auto streams : interleave)
+				evaluateStorageCalculator<LineMandelCalculator>(precision, storage, baseSize, iters, output, batchMode, classify, mode, periodicity, compact, streams, costPartition, smooth);
+		}
+		else if (calculator == "line512")
+		{
+			evaluateCalculator<Line512MandelCalculator>(baseSize, iters, output, batchMode, classify, mode);
 		}
 		else if (calculator == "batch")
 		{
-			evaluateCalculator<BatchMandelCalculator>(args["size"].as<unsigned>(), args["iters"].as<unsigned>(), args["output"].as<std::string>(), args.count("batch"));
+			for (auto streams : interleave)
+				evaluateStorageCalculator<BatchMandelCalculator>(precision, storage, baseSize, iters, output, batchMode, classify, mode, periodicity, refill, streams, costPartition);
+		}
+		else if (calculator == "tiled")
+		{
+			evaluateStorageCalculator<TiledMandelCalculator>(precision, storage, baseSize, iters, output, batchMode, classify, mode, unroll);
+		}
+		else if (calculator == "mixed")
+		{
+			evaluateCalculator<MixedMandelCalculator>(baseSize, iters, output, batchMode, classify, mode);
+		}
+		else if (calculator == "perturbation")
+		{
+			evaluatePrecisionCalculator<PerturbationMandelCalculator>(precision, baseSize, iters, output, batchMode, classify, mode, (bool)args.count("series"));
+		}
+		else if (calculator == "subdivision")
+		{
+			evaluatePrecisionCalculator<SubdivisionMandelCalculator>(precision, baseSize, iters, output, batchMode, classify, mode);
+		}
+		else if (calculator == "trace")
+		{
+			evaluatePrecisionCalculator<BoundaryTraceMandelCalculator>(precision, baseSize, iters, output, batchMode, classify, mode);
+		}
+		else if (calculator == "multibrot2")
+		{
+			evaluateStorageCalculator<Multibrot2Calculator>(precision, storage, baseSize, iters, output, batchMode, classify, mode);
+		}
+		else if (calculator == "multibrot3")
+		{
+			evaluateStorageCalculator<Multibrot3Calculator>(precision, storage, baseSize, iters, output, batchMode, classify, mode);
+		}
+		else if (calculator == "multibrot4")
+		{
+			evaluateStorageCalculator<Multibrot4Calculator>(precision, storage, baseSize, iters, output, batchMode, classify, mode);
+		}
+		else if (calculator == "julia")
+		{
+			evaluateStorageCalculator<JuliaCalculator>(precision, storage, baseSize, iters, output, batchMode, classify, mode, juliaRe, juliaIm);
+		}
+		else if (calculator == "julia3")
+		{
+			evaluateStorageCalculator<Julia3Calculator>(precision, storage, baseSize, iters, output, batchMode, classify, mode, juliaRe, juliaIm);
+		}
+		else if (calculator == "julia4")
+		{
+			evaluateStorageCalculator<Julia4Calculator>(precision, storage, baseSize, iters, output, batchMode, classify, mode, juliaRe, juliaIm);
+		}
+		else if (calculator == "burningship")
+		{
+			evaluateStorageCalculator<BurningShipCalculator>(precision, storage, baseSize, iters, output, batchMode, classify, mode);
 		}
 		else
 		{
@@ -0,0 +1,277 @@
+/**
+ * @file    merge.cc
+ *
+ * @authors Matěj Konopík <xkonop03@stud.fit.vutbr.cz>
+ *
+ * @brief   Assembles the .npy bands calculated by mandelbrot --shard i/N into one array
+ *
+ *          The bands are streamed into the output in the given order, the whole image is never held
+ *          in memory. With --mirror the bands hold the first half of a symmetric image of --height lines
+ *          and the second half is streamed from them in the reverse order of the lines (an odd height has
+ *          the axis line in the first half only). The output is a .npy file, or
+ *          an uncompressed .npz with the array "d" (as saved by mandelbrot) when its name ends with .npz.
+ *          With --queue-dir the bands are the raw tiles of the queue of mandelbrot --queue-dir, mirrored
+ *          when its manifest says so.
+ *
+ * @date    16 October 2026
+ **/
+#include <iostream>
+#include <string>
+#include <vector>
+#include <cstdio>
+#include <cstdint>
+#include <stdexcept>
+
+#include <zlib.h>
+
+#include "cxxopts.hpp"
+
+#include "cnpy.h"
+#include "tile_queue.h"
+
+using cnpy::operator+=;
+
+#define MERGE_CHUNK_ROWS 64 // lines copied at once
+#define ZIP32_LIMIT 0xffffffffUL // largest entry of a zip without the zip64 extension
+
+/**
+ * @brief Band file opened at the start of its data
+ **/
+struct Band
+{
+	std::string name;
+	FILE *fp;
+	size_t rows;
+	size_t width;
+	long dataOffset;
+};
+
+static Band openBand(const std::string &name)
+{
+	Band band = {name, fopen(name.c_str(), "rb"), 0, 0, 0};
+	if (band.fp == NULL)
+		throw std::runtime_error("Cannot open band " + name);
+
+	size_t wordSize;
+	bool fortranOrder;
+	std::vector<size_t> shape;
+	cnpy::parse_npy_header(band.fp, wordSize, shape, fortranOrder);
+	if (shape.size() != 2 || wordSize != sizeof(int) || fortranOrder)
+		throw std::runtime_error("Band " + name + " is not a C ordered 2D array of 32-bit integers");
+	band.rows = shape[0];
+	band.width = shape[1];
+	band.dataOffset = ftell(band.fp);
+	return band;
+}
+
+/**
+ * @brief Opens a finished tile of the queue, raw lines without a header
+ **/
+static Band openTile(const std::string &dir, const QueueManifest &manifest, int tile)
+{
+	const std::string name = TileQueue::tilePath(dir, tile);
+	Band band = {name, fopen(name.c_str(), "rb"), (size_t)manifest.tileLines(tile), (size_t)manifest.width, 0};
+	if (band.fp == NULL)
+		throw std::runtime_error("Tile " + std::to_string(tile) + " of the queue is not finished (" + name + ")");
+	fseek(band.fp, 0, SEEK_END);
+	if ((size_t)ftell(band.fp) != band.rows * band.width * sizeof(int))
+		throw std::runtime_error("Tile " + name + " has a wrong size");
+	fseek(band.fp, 0, SEEK_SET);
+	return band;
+}
+
+/**
+ * @brief Output array, keeps the CRC of everything written for the zip entry
+ **/
+class Output
+{
+public:
+	Output(const std::string &name, const std::vector<size_t> &shape) : zip(name.size() > 4 && name.compare(name.size() - 4, 4, ".npz") == 0), crc(crc32(0L, Z_NULL, 0))
+	{
+		fp = fopen(name.c_str(), "wb");
+		if (fp == NULL)
+			throw std::runtime_error("Cannot create " + name);
+
+		const std::vector<char> npyHeader = cnpy::create_npy_header<int>(shape);
+		entryBytes = npyHeader.size() + shape[0] * shape[1] * sizeof(int);
+		if (zip)
+		{
+			if (entryBytes > ZIP32_LIMIT)
+				throw std::runtime_error("The array does not fit into a .npz, save it as .npy");
+			// the CRC is not known yet, it is patched in close()
+			localHeader += "PK";
+			localHeader += (uint16_t)0x0403;
+			localHeader += (uint16_t)20;
+			localHeader += (uint16_t)0;
+			localHeader += (uint16_t)0;
+			localHeader += (uint16_t)0;
+			localHeader += (uint16_t)0;
+			localHeader += (uint32_t)0;
+			localHeader += (uint32_t)entryBytes;
+			localHeader += (uint32_t)entryBytes;
+			localHeader += (uint16_t)entryName.size();
+			localHeader += (uint16_t)0;
+			localHeader += entryName;
+			fwrite(&localHeader[0], sizeof(char), localHeader.size(), fp);
+		}
+		write(npyHeader.data(), npyHeader.size());
+	}
+
+	void write(const void *data, size_t bytes)
+	{
+		if (fwrite(data, sizeof(char), bytes, fp) != bytes)
+			throw std::runtime_error("Write failed");
+		if (zip)
+			crc = crc32(crc, (const Bytef *)data, bytes);
+	}
+
+	void close()
+	{
+		if (zip)
+		{
+			// local header with the final CRC, then the central directory of the single entry
+			for (int byte = 0; byte < 4; byte++)
+				localHeader[14 + byte] = (char)(crc >> (8 * byte));
+			std::vector<char> globalHeader;
+			globalHeader += "PK";
+			globalHeader += (uint16_t)0x0201;
+			globalHeader += (uint16_t)20;
+			globalHeader.insert(globalHeader.end(), localHeader.begin() + 4, localHeader.begin() + 30);
+			globalHeader += (uint16_t)0;
+			globalHeader += (uint16_t)0;
+			globalHeader += (uint16_t)0;
+			globalHeader += (uint32_t)0;
+			globalHeader += (uint32_t)0;
+			globalHeader += entryName;
+
+			std::vector<char> footer;
+			footer += "PK";
+			footer += (uint16_t)0x0605;
+			footer += (uint16_t)0;
+			footer += (uint16_t)0;
+			footer += (uint16_t)1;
+			footer += (uint16_t)1;
+			footer += (uint32_t)globalHeader.size();
+			footer += (uint32_t)(localHeader.size() + entryBytes);
+			footer += (uint16_t)0;
+
+			fwrite(&globalHeader[0], sizeof(char), globalHeader.size(), fp);
+			fwrite(&footer[0], sizeof(char), footer.size(), fp);
+			fseek(fp, 0, SEEK_SET);
+			fwrite(&localHeader[0], sizeof(char), localHeader.size(), fp);
+		}
+		if (fclose(fp) != 0)
+			throw std::runtime_error("Write failed");
+	}
+
+private:
+	FILE *fp;
+	const bool zip;
+	const std::string entryName = "d.npy";
+	std::vector<char> localHeader;
+	size_t entryBytes;
+	uLong crc;
+};
+
+int main(int argc, char *argv[])
+{
+	cxxopts::Options options("mandelbrot-merge", "Assembles the bands of mandelbrot --shard i/N into one array");
+	options.add_options()
+		("o,output", "Output .npy or .npz file", cxxopts::value<std::string>())
+		("mirror", "The bands hold the first half of a symmetric image, append the mirrored second half")
+		("height", "Height of the mirrored image, required by --mirror (printed by mandelbrot --shard)", cxxopts::value<size_t>())
+		("queue-dir", "Assemble the tiles of the queue of mandelbrot --queue-dir instead of band files", cxxopts::value<std::string>())
+		("bands", "Band .npy files from the top of the image down", cxxopts::value<std::vector<std::string>>())
+		("h,help", "Print help");
+	options.parse_positional({"bands"});
+	options.positional_help("<BAND>...");
+
+	try
+	{
+		auto args = options.parse(argc, argv);
+		if (args.count("help") || !args.count("output") || args.count("bands") == args.count("queue-dir"))
+		{
+			std::cout << options.help() << std::endl;
+			std::exit(args.count("help") ? 0 : 1);
+		}
+
+		std::vector<Band> bands;
+		size_t rows = 0;
+		bool mirror = args.count("mirror");
+		size_t height = args.count("height") ? args["height"].as<size_t>() : 0;
+		if (mirror && !height)
+			throw std::runtime_error("The height of the mirrored image is not known, give it by --height");
+		if (args.count("queue-dir"))
+		{
+			const std::string dir = args["queue-dir"].as<std::string>();
+			const QueueManifest manifest = TileQueue::readManifest(dir);
+			for (int tile = 0; tile < manifest.tiles; tile++)
+				bands.push_back(openTile(dir, manifest, tile));
+			rows = manifest.rows;
+			mirror = manifest.symmetric;
+			height = manifest.height;
+		}
+		for (const auto &name : args.count("bands") ? args["bands"].as<std::vector<std::string>>() : std::vector<std::string>())
+		{
+			bands.push_back(openBand(name));
+			if (bands.back().width != bands.front().width)
+				throw std::runtime_error("Band " + name + " has a different width than " + bands.front().name);
+			rows += bands.back().rows;
+		}
+		const size_t width = bands.front().width;
+		if (!mirror)
+			height = rows;
+		if (height != (mirror ? 2 * rows - height % 2 : rows))
+			throw std::runtime_error("The bands hold " + std::to_string(rows) + " lines, not " + (mirror ? "the first half" : "all") +
+									 " of the " + std::to_string(height) + " lines of the image");
+
+		Output output(args["output"].as<std::string>(), {height, width});
+		std::vector<int> chunk(MERGE_CHUNK_ROWS * width);
+
+		// first half (or the whole image) band by band
+		for (auto &band : bands)
+		{
+			for (size_t row = 0; row < band.rows; row += MERGE_CHUNK_ROWS)
+			{
+				const size_t count = std::min((size_t)MERGE_CHUNK_ROWS, band.rows - row) * width;
+				if (fread(chunk.data(), sizeof(int), count, band.fp) != count)
+					throw std::runtime_error("Band " + band.name + " is truncated");
+				output.write(chunk.data(), count * sizeof(int));
+			}
+		}
+
+		// mirrored second half, the lines of the bands in the reverse order, the axis line of an odd height once only
+		size_t skip = 2 * rows - height;
+		for (auto band = bands.rbegin(); mirror && band != bands.rend(); band++)
+		{
+			for (size_t row = band->rows; row > 0; row--)
+			{
+				if (skip > 0)
+				{
+					skip--;
+					continue;
+				}
+				fseek(band->fp, band->dataOffset + (long)((row - 1) * width * sizeof(int)), SEEK_SET);
+				if (fread(chunk.data(), sizeof(int), width, band->fp) != width)
+					throw std::runtime_error("Band " + band->name + " is truncated");
+				output.write(chunk.data(), width * sizeof(int));
+			}
+		}
+		output.close();
+
+		for (auto &band : bands)
+			fclose(band.fp);
+	}
+	catch (const cxxopts::OptionException &e)
+	{
+		std::cerr << "Invalid options specified: " << e.what() << std::endl;
+		std::exit(1);
+	}
+	catch (const std::runtime_error &e)
+	{
+		std::cerr << e.what() << std::endl;
+		std::exit(1);
+	}
+
+	return 0;
+}
@@ -4,20 +4,21 @@ import numpy as np
 import argparse
 
 
-def main(file1=None, file2=None):
+def main(file1=None, file2=None, strict=False):
 
     fail = "[\033[91mfail\033[0m]"
     ok = "[\033[92mok\033[0m]"
 
 
     try:
-        a1 = np.load(file1)["d"]
+        # the counts may be stored in unsigned types narrower than the differences
+        a1 = np.load(file1)["d"].astype(np.int64)
     except Exception as e:
         print(f"{fail} Error during loading {file1}: {e}")
         return False
 
     try:
-        a2 = np.load(file2)["d"]
+        a2 = np.load(file2)["d"].astype(np.int64)
     except Exception as e:
         print(f"{fail} Error during loading {file2}: {e}")
         return False
@@ -38,6 +39,11 @@ def main(file1=None, file2=None):
 
     if((diff <= 1).all()):
         print(f"{ok} Results are same")
+        return True
+
+    elif strict:
+        # the set membership only is not enough, every count has to be within 1
+        print(f"{fail} Results differs in {np.sum(diff > 1)} values by more than 1")
 
     elif close < 0.001:
         print(f"{ok} Results are very close (eps = {close:.3%} )")
@@ -62,6 +68,8 @@ if __name__ == "__main__":
     parser = argparse.ArgumentParser(description="Compare two npz files")
     parser.add_argument("file1", type=str)
     parser.add_argument("file2", type=str)
+    parser.add_argument("--strict", action="store_true",
+                        help="require every count to be within 1, not only the set membership to match")
 
 
     args = parser.parse_args()
@@ -1,7 +1,7 @@
 
 
 SCRIPT_ROOT_PATH="$( cd "$( dirname "${BASH_SOURCE[0]}" )" >/dev/null && pwd )"
-CALCULATORS=("ref" "line" "batch")
+CALCULATORS=("ref" "line" "line512" "batch" "tiled" "mixed" "subdivision" "trace" "multibrot2")
 
 for calc in "${CALCULATORS[@]}"; do
     ./mandelbrot -s 512 -i 100 -c $calc --batch cmp_$calc.npz
@@ -11,13 +11,57 @@ VALID=1
 echo "Reference vs line"
 python3 ${SCRIPT_ROOT_PATH}/compare.py cmp_ref.npz cmp_line.npz  || VALID=0
 
+echo "Reference vs line512"
+python3 ${SCRIPT_ROOT_PATH}/compare.py cmp_ref.npz cmp_line512.npz || VALID=0
+
 echo "Reference vs batch"
 python3 ${SCRIPT_ROOT_PATH}/compare.py cmp_ref.npz cmp_batch.npz || VALID=0
 
 
+echo "Reference vs tiled"
+python3 ${SCRIPT_ROOT_PATH}/compare.py cmp_ref.npz cmp_tiled.npz || VALID=0
+
+echo "Reference vs mixed"
+python3 ${SCRIPT_ROOT_PATH}/compare.py cmp_ref.npz cmp_mixed.npz || VALID=0
+
+echo "Reference vs subdivision"
+python3 ${SCRIPT_ROOT_PATH}/compare.py cmp_ref.npz cmp_subdivision.npz || VALID=0
+
+echo "Reference vs trace"
+python3 ${SCRIPT_ROOT_PATH}/compare.py cmp_ref.npz cmp_trace.npz || VALID=0
+
+echo "Reference vs multibrot2"
+python3 ${SCRIPT_ROOT_PATH}/compare.py cmp_ref.npz cmp_multibrot2.npz || VALID=0
+
 echo "Batch vs line"
 python3 ${SCRIPT_ROOT_PATH}/compare.py cmp_line.npz cmp_batch.npz || VALID=0
 
+echo "Line vs trace (strict)"
+python3 ${SCRIPT_ROOT_PATH}/compare.py --strict cmp_line.npz cmp_trace.npz || VALID=0
+
+echo "Subdivision vs trace (strict)"
+python3 ${SCRIPT_ROOT_PATH}/compare.py --strict cmp_subdivision.npz cmp_trace.npz || VALID=0
+
+# the windows of --procs and --shard have to give their lines the values of the whole image, an odd height
+# rounds the line values of a window computed from its own first line differently
+WINDOW_CALCULATORS=("ref" "line" "batch" "tiled" "multibrot2")
+SHARDS=5
+for calc in "${WINDOW_CALCULATORS[@]}"; do
+    ./mandelbrot -s 200 -i 300 --height 333 -c $calc --batch cmp_window_$calc.npz
+    ./mandelbrot -s 200 -i 300 --height 333 -c $calc --procs 2 --batch cmp_procs_$calc.npz
+    for ((shard = 0; shard < SHARDS; shard++)); do
+        merge_options=$(./mandelbrot -s 200 -i 300 --height 333 -c $calc --shard $shard/$SHARDS cmp_shard_$shard.npy \
+                        | sed -n 's/^Merge: *mandelbrot-merge//p')
+    done
+    ./mandelbrot-merge $merge_options -o cmp_shards_$calc.npz \
+        $(for ((shard = 0; shard < SHARDS; shard++)); do echo cmp_shard_$shard.npy; done) || VALID=0
+
+    echo "$calc vs $calc in 2 processes (strict, odd height)"
+    python3 ${SCRIPT_ROOT_PATH}/compare.py --strict cmp_window_$calc.npz cmp_procs_$calc.npz || VALID=0
+    echo "$calc vs $calc in $SHARDS shards (strict, odd height)"
+    python3 ${SCRIPT_ROOT_PATH}/compare.py --strict cmp_window_$calc.npz cmp_shards_$calc.npz || VALID=0
+done
+
 if [ "$VALID" -eq 1 ]; then
     echo "Test passed";
 else
@@ -6,7 +6,9 @@ import argparse
 
 
 def plot_visualize(filename="datalog.csv", show=False, save=None):
-    res = np.load(filename)["d"]
+    archive = np.load(filename)
+    # the smooth iteration counts (--smooth) do not band, the integer counts otherwise
+    res = archive["s"] if "s" in archive.files else archive["d"]
     width, height = res.shape
 
     dpi = 72